@@ -74,6 +74,21 @@ static int strip_c_option;
 /* customisation for using the SWIG compiler */
 static int swig;
 
+/* can we look up SWIG results via a manifest without running the preprocessor? */
+static int direct_mode;
+
+/* was the result found via the direct mode manifest? */
+static int direct_hit;
+
+/* the name of the direct mode manifest file */
+static char *manifest_name;
+
+/* the name of the dependency file written by the preprocessor in direct mode */
+static char *dep_tmpfile;
+
+/* the hash found by running the preprocessor, recorded in the manifest */
+static char *result_hash;
+
 /* a list of supported file extensions, and the equivalent
    extension for code that has been through the pre-processor
 */
@@ -119,6 +134,13 @@ static void failed(void)
 		cpp_stderr = NULL;
 	}
 
+	/* delete the dependency file if necessary */
+	if (dep_tmpfile) {
+		unlink(dep_tmpfile);
+		free(dep_tmpfile);
+		dep_tmpfile = NULL;
+	}
+
 	/* strip any local args */
 	args_strip(orig_args, "--ccache-");
 
@@ -199,6 +221,207 @@ static const char *tmp_string(void)
 	return ret;
 }
 
+/* form the cache path for a hash result. We use a N level subdir for
+   the cache path to reduce the impact on filesystems which are slow for
+   large directories */
+static char *hash_path(const char *s)
+{
+	int i;
+	int nlevels = 2;
+	char *hash_dir;
+	char *path;
+	char *p;
+
+	if ((p = getenv("CCACHE_NLEVELS"))) {
+		nlevels = atoi(p);
+		if (nlevels < 1) nlevels = 1;
+		if (nlevels > 8) nlevels = 8;
+	}
+
+	x_asprintf(&hash_dir, "%s/%c", cache_dir, s[0]);
+	x_asprintf(&stats_file, "%s/stats", hash_dir);
+	for (i=1; i<nlevels; i++) {
+		if (create_dir(hash_dir) != 0) {
+			cc_log("failed to create %s\n", hash_dir);
+			stats_update(STATS_ERROR);
+			failed();
+		}
+		x_asprintf(&p, "%s/%c", hash_dir, s[i]);
+		free(hash_dir);
+		hash_dir = p;
+	}
+	if (create_dir(hash_dir) != 0) {
+		cc_log("failed to create %s\n", hash_dir);
+		stats_update(STATS_ERROR);
+		failed();
+	}
+	x_asprintf(&path, "%s/%s", hash_dir, s+nlevels);
+	free(hash_dir);
+	return path;
+}
+
+/* strip the line ending from a line read with fgets. Returns 0 if the
+   line was truncated */
+static int strip_eol(char *line)
+{
+	char *linefeed = strchr(line, '\n');
+	if (!linefeed) {
+		return 0;
+	}
+	*linefeed = 0;
+	if (linefeed > line && linefeed[-1] == '\r') {
+		linefeed[-1] = 0;
+	}
+	return 1;
+}
+
+/* check the files listed in a direct mode manifest against their
+   recorded hashes. Returns the hash of the cached result if none of
+   them have changed, otherwise NULL */
+static char *manifest_lookup(const char *fname)
+{
+	FILE *file;
+	char line[FILENAME_MAX + 64];
+	char *result;
+
+	file = fopen(fname, "r");
+	if (!file) {
+		return NULL;
+	}
+
+	/* the first line is the result, followed by a line per dependency */
+	if (!fgets(line, sizeof(line), file) || !strip_eol(line)) {
+		fclose(file);
+		return NULL;
+	}
+	result = x_strdup(line);
+
+	while (fgets(line, sizeof(line), file)) {
+		char *path = strchr(line, ' ');
+		char *digest;
+		if (!path || !strip_eol(line)) {
+			cc_log("corrupt manifest %s\n", fname);
+			free(result);
+			result = NULL;
+			break;
+		}
+		*path++ = 0;
+		digest = hash_file_digest(path);
+		if (!digest || strcmp(digest, line) != 0) {
+			cc_log("%s has changed since %s was cached\n", path, input_file);
+			free(digest);
+			free(result);
+			result = NULL;
+			break;
+		}
+		free(digest);
+	}
+	fclose(file);
+
+	return result;
+}
+
+/* write the direct mode manifest for a result, listing each file named
+   in the dependency output of the preprocessor run along with the hash of
+   its contents. Returns the size of the manifest if it was newly created */
+static size_t manifest_update(const char *result)
+{
+	FILE *deps, *file;
+	char line[FILENAME_MAX + 1];
+	char *tmp_manifest;
+	struct stat st;
+	int existed, ok = 1;
+
+	deps = fopen(dep_tmpfile, "r");
+	if (!deps) {
+		/* an older SWIG which does not honour -MD with -E */
+		cc_log("no dependencies for %s\n", input_file);
+		free(dep_tmpfile);
+		dep_tmpfile = NULL;
+		return 0;
+	}
+
+	x_asprintf(&tmp_manifest, "%s.tmp.%s", manifest_name, tmp_string());
+	file = fopen(tmp_manifest, "w");
+	if (!file) {
+		cc_log("failed to create %s - %s\n", tmp_manifest, strerror(errno));
+		fclose(deps);
+		unlink(dep_tmpfile);
+		free(dep_tmpfile);
+		dep_tmpfile = NULL;
+		free(tmp_manifest);
+		return 0;
+	}
+	fprintf(file, "%s\n", result);
+
+	/* the first line is the rule target, then one dependency per line in
+	   the form "  file \" */
+	if (fgets(line, sizeof(line), deps) && strip_eol(line)) {
+		while (ok && fgets(line, sizeof(line), deps)) {
+			char *path = line;
+			char *end;
+			char *digest;
+			if (!strip_eol(line)) {
+				ok = 0;
+				break;
+			}
+			while (*path == ' ') {
+				path++;
+			}
+			end = path + strlen(path);
+			if (end > path && end[-1] == '\\') {
+				end--;
+			}
+			if (end > path && end[-1] == ' ') {
+				end--;
+			}
+			*end = 0;
+			if (!*path) {
+				continue;
+			}
+			digest = hash_file_digest(path);
+			if (!digest) {
+				cc_log("failed to hash dependency %s\n", path);
+				ok = 0;
+				break;
+			}
+			fprintf(file, "%s %s\n", digest, path);
+			free(digest);
+		}
+	} else {
+		ok = 0;
+	}
+
+	fclose(deps);
+	unlink(dep_tmpfile);
+	free(dep_tmpfile);
+	dep_tmpfile = NULL;
+
+	if (fclose(file) != 0 || !ok) {
+		unlink(tmp_manifest);
+		free(tmp_manifest);
+		return 0;
+	}
+
+	/* unlike the results, a manifest is replaced when it is out of date */
+	existed = (stat(manifest_name, &st) == 0);
+#ifdef _WIN32
+	unlink(manifest_name);
+#endif
+	if (rename(tmp_manifest, manifest_name) != 0) {
+		cc_log("failed to rename %s - %s\n", tmp_manifest, strerror(errno));
+		unlink(tmp_manifest);
+		free(tmp_manifest);
+		return 0;
+	}
+	free(tmp_manifest);
+
+	if (existed || stat(manifest_name, &st) != 0) {
+		return 0;
+	}
+	return file_size(&st);
+}
+
 /* update cached file sizes and count helper function for to_cache() */
 static void to_cache_stats_helper(struct stat *pstat, char *cached_filename, char *tmp_outfiles, int *files_size, int *cached_files_count)
 {
@@ -311,6 +534,9 @@ static void to_cache(ARGS *args)
 			if (i_tmpfile && !direct_i_file) {
 				unlink(i_tmpfile);
 			}
+			if (dep_tmpfile) {
+				unlink(dep_tmpfile);
+			}
 			exit(status);
 		}
 		
@@ -395,6 +621,14 @@ static void to_cache(ARGS *args)
 
 	to_cache_stats_helper(&st1, path_stderr, 0, &files_size, &cached_files_count);
 
+	if (dep_tmpfile) {
+		size_t manifest_size = manifest_update(result_hash);
+		if (manifest_size) {
+			files_size += manifest_size;
+			cached_files_count++;
+		}
+	}
+
 	cc_log("Placed %d files for %s into cache\n", cached_files_count, input_file);
 	stats_tocache(files_size, cached_files_count);
 
@@ -404,25 +638,83 @@ static void to_cache(ARGS *args)
 	free(path_stderr);
 }
 
+/* find the hash for a SWIG command in direct mode. This hashes the input
+   file, all the arguments and the compiler, but not the preprocessor
+   output. It names a manifest of the files that the input depended on the
+   last time round, so if none of them have changed, the cached result
+   can be used without running the preprocessor. Returns the name of the
+   cached result, or NULL if it must be found with find_hash() */
+static char *find_direct_hash(ARGS *args)
+{
+	int i;
+	char *s;
+	char *path;
+	struct stat st;
+
+	if (stat(args->argv[0], &st) != 0) {
+		/* let find_hash() report this */
+		return NULL;
+	}
+
+	hash_start();
+	hash_string(input_file);
+	if (output_file) {
+		hash_string(output_file);
+	}
+
+	/* include paths and macros matter as the preprocessor is not run */
+	for (i=1;i<args->argc;i++) {
+		hash_string(args->argv[i]);
+	}
+
+	if (st.st_nlink > 1) {
+		hash_string(str_basename(args->argv[0]));
+	}
+	hash_int(st.st_size);
+	hash_int(st.st_mtime);
+
+	if (getenv("CCACHE_HASHDIR")) {
+		char *cwd = gnu_getcwd();
+		if (cwd) {
+			hash_string(cwd);
+			free(cwd);
+		}
+	}
+
+	/* these change the files SWIG reads and the options it uses */
+	if ((s = getenv("SWIG_LIB"))) {
+		hash_string(s);
+	}
+	if ((s = getenv("SWIG_FEATURES"))) {
+		hash_string(s);
+	}
+
+	hash_file(input_file);
+
+	path = hash_path(hash_result());
+	x_asprintf(&manifest_name, "%s.manifest", path);
+	free(path);
+
+	s = manifest_lookup(manifest_name);
+	if (!s) {
+		return NULL;
+	}
+	path = hash_path(s);
+	free(s);
+	return path;
+}
+
 /* find the hash for a command. The hash includes all argument lists,
    plus the output from running the compiler with -E */
 static void find_hash(ARGS *args)
 {
 	int i;
 	char *path_stdout, *path_stderr;
-	char *hash_dir;
 	char *s;
 	struct stat st;
 	int status;
-	int nlevels = 2;
 	char *input_base;
 	char *tmp;
-	
-	if ((s = getenv("CCACHE_NLEVELS"))) {
-		nlevels = atoi(s);
-		if (nlevels < 1) nlevels = 1;
-		if (nlevels > 8) nlevels = 8;
-	}
 
 	hash_start();
 
@@ -526,10 +818,17 @@ static void find_hash(ARGS *args)
 
 	if (!direct_i_file) {
 		/* run cpp on the input file to obtain the .i */
+		if (direct_mode) {
+			/* have SWIG list the files it reads for the manifest */
+			x_asprintf(&dep_tmpfile, "%s/tmp.deps.%s", temp_dir, tmp_string());
+			args_add(args, "-MD");
+			args_add(args, "-MF");
+			args_add(args, dep_tmpfile);
+		}
 		args_add(args, "-E");
 		args_add(args, input_file);
 		status = execute(args->argv, path_stdout, path_stderr);
-		args_pop(args, 2);
+		args_pop(args, direct_mode ? 5 : 2);
 	} else {
 		/* we are compiling a .i or .ii file - that means we
 		   can skip the cpp stage and directly form the
@@ -571,6 +870,14 @@ static void find_hash(ARGS *args)
 	}
 	hash_file(path_stderr);
 
+	/* warnings from the preprocessor are not kept in the cache, so
+	   compiles giving them always have to run the preprocessor */
+	if (dep_tmpfile && (stat(path_stderr, &st) != 0 || st.st_size != 0)) {
+		unlink(dep_tmpfile);
+		free(dep_tmpfile);
+		dep_tmpfile = NULL;
+	}
+
 	i_tmpfile = path_stdout;
 
 	if (!getenv("CCACHE_CPP2")) {
@@ -583,30 +890,11 @@ static void find_hash(ARGS *args)
 		free(path_stderr);
 	}
 
-	/* we use a N level subdir for the cache path to reduce the impact
-	   on filesystems which are slow for large directories
-	*/
 	s = hash_result();
-	x_asprintf(&hash_dir, "%s/%c", cache_dir, s[0]);
-	x_asprintf(&stats_file, "%s/stats", hash_dir);
-	for (i=1; i<nlevels; i++) {
-		char *p;
-		if (create_dir(hash_dir) != 0) {
-			cc_log("failed to create %s\n", hash_dir);
-			stats_update(STATS_ERROR);
-			failed();
-		}
-		x_asprintf(&p, "%s/%c", hash_dir, s[i]);
-		free(hash_dir);
-		hash_dir = p;
-	}
-	if (create_dir(hash_dir) != 0) {
-		cc_log("failed to create %s\n", hash_dir);
-		stats_update(STATS_ERROR);
-		failed();
+	hashname = hash_path(s);
+	if (dep_tmpfile) {
+		result_hash = x_strdup(s);
 	}
-	x_asprintf(&hashname, "%s/%s", hash_dir, s+nlevels);
-	free(hash_dir);
 }
 
 /* 
@@ -719,6 +1007,12 @@ static void from_cache(int first)
 			return;
 		}
 		free(stderr_file);
+
+		/* the result was found by running the preprocessor, so
+		   direct mode can find it next time */
+		if (dep_tmpfile) {
+			manifest_update(result_hash);
+		}
 	}
 
 	/* get rid of the intermediate preprocessor file */
@@ -731,7 +1025,7 @@ static void from_cache(int first)
 	}
 
 	/* send the cpp stderr, if applicable */
-	fd_cpp_stderr = open(cpp_stderr, O_RDONLY | O_BINARY);
+	fd_cpp_stderr = cpp_stderr ? open(cpp_stderr, O_RDONLY | O_BINARY) : -1;
 	if (fd_cpp_stderr != -1) {
 		copy_fd(fd_cpp_stderr, 2);
 		close(fd_cpp_stderr);
@@ -748,6 +1042,9 @@ static void from_cache(int first)
 	if (first) {
 		cc_log("got cached result for %s\n", input_file);
 		stats_update(STATS_CACHED);
+		if (direct_hit) {
+			stats_update(STATS_DIRECT);
+		}
 	}
 
 	exit(0);
@@ -1049,6 +1346,12 @@ static void process_args(int argc, char **argv)
 		failed();
 	}
 
+	/* the direct mode relies on SWIG's own dependency generation, so
+	   cannot be used if the user is asking for dependencies too */
+	if (swig && !direct_i_file && !generating_dependencies && !getenv("CCACHE_NODIRECT")) {
+		direct_mode = 1;
+	}
+
 	if (!swig && !output_file) {
 		char *p;
 		output_file = x_strdup(input_file);
@@ -1161,6 +1464,18 @@ static void ccache(int argc, char *argv[])
 	/* process argument list, returning a new set of arguments for pre-processing */
 	process_args(orig_args->argc, orig_args->argv);
 
+	/* SWIG can often skip the preprocessor by using a manifest */
+	if (direct_mode) {
+		hashname = find_direct_hash(stripped_args);
+		if (hashname) {
+			direct_hit = 1;
+			from_cache(1);
+			direct_hit = 0;
+			free(hashname);
+			hashname = NULL;
+		}
+	}
+
 	/* run with -E to find the hash */
 	find_hash(stripped_args);
 
@@ -89,6 +89,8 @@ enum stats {
 	STATS_CONFTEST,
 	STATS_UNSUPPORTED,
 	STATS_OUTSTDOUT,
+	STATS_DIRECT,
+	STATS_JOURNAL,
 
 	STATS_END
 };
@@ -96,6 +98,7 @@ enum stats {
 typedef unsigned uint32;
 
 #include "mdfour.h"
+#include "murmur3.h"
 
 void hash_start(void);
 void hash_string(const char *s);
@@ -103,6 +106,7 @@ void hash_int(int x);
 void hash_file(const char *fname);
 char *hash_result(void);
 void hash_buffer(const char *s, int len);
+char *hash_file_digest(const char *fname);
 
 void cc_log(const char *format, ...);
 void fatal(const char *msg);
@@ -145,6 +149,7 @@ int stats_set_limits(long maxfiles, long maxsize);
 size_t value_units(const char *s);
 void display_size(unsigned v);
 void stats_set_sizes(const char *dir, size_t num_files, size_t total_size);
+void stats_remove_files(const char *dir, size_t num_files, size_t total_size);
 
 int unify_hash(const char *fname);
 
@@ -160,6 +165,7 @@ int snprintf(char *,size_t ,const char *, ...);
 #endif
 
 void cleanup_dir(const char *dir, size_t maxfiles, size_t maxsize);
+void cleanup_incremental(const char *dir, unsigned counters[STATS_END]);
 void cleanup_all(const char *dir);
 void wipe_all(const char *dir);
 
@@ -32,6 +32,17 @@ static size_t total_size;
 static size_t total_files;
 static size_t size_threshold;
 static size_t files_threshold;
+static size_t removed_files;
+static size_t removed_size;
+
+/* the stats file and its journal are not cached files */
+static int is_stats_file(const char *fname)
+{
+	char *p = str_basename(fname);
+	int ret = (strcmp(p, "stats") == 0 || strcmp(p, "stats.journal") == 0);
+	free(p);
+	return ret;
+}
 
 /* file comparison function to try to delete the oldest files first */
 static int files_compare(struct files **f1, struct files **f2)
@@ -48,16 +59,9 @@ static int files_compare(struct files **f1, struct files **f2)
 /* this builds the list of files in the cache */
 static void traverse_fn(const char *fname, struct stat *st)
 {
-	char *p;
-
 	if (!S_ISREG(st->st_mode)) return;
 
-	p = str_basename(fname);
-	if (strcmp(p, "stats") == 0) {
-		free(p);
-		return;
-	}
-	free(p);
+	if (is_stats_file(fname)) return;
 
 	if (num_files == allocated) {
 		allocated = 10000 + num_files*2;
@@ -102,24 +106,24 @@ static void sort_and_clean(void)
 	total_files = num_files - i;
 }
 
-/* cleanup in one cache subdir */
-void cleanup_dir(const char *dir, size_t maxfiles, size_t maxsize)
+/* clean a dir down to the thresholds, leaving the number and size of
+   the files remaining in total_files and total_size, and of those
+   deleted in removed_files and removed_size */
+static void clean_dir(const char *dir)
 {
 	unsigned i;
 
-	size_threshold = maxsize * LIMIT_MULTIPLE;
-	files_threshold = maxfiles * LIMIT_MULTIPLE;
-
 	num_files = 0;
 	total_size = 0;
 
 	/* build a list of files */
 	traverse(dir, traverse_fn);
+	removed_size = total_size;
 
 	/* clean the cache */
 	sort_and_clean();
-
-	stats_set_sizes(dir, total_files, total_size);
+	removed_files = num_files - total_files;
+	removed_size -= total_size;
 
 	/* free it up */
 	for (i=0;i<num_files;i++) {
@@ -132,9 +136,79 @@ void cleanup_dir(const char *dir, size_t maxfiles, size_t maxsize)
 	files = NULL;
 
 	num_files = 0;
+}
+
+/* cleanup in one cache subdir */
+void cleanup_dir(const char *dir, size_t maxfiles, size_t maxsize)
+{
+	size_threshold = maxsize * LIMIT_MULTIPLE;
+	files_threshold = maxfiles * LIMIT_MULTIPLE;
+
+	clean_dir(dir);
+
+	stats_set_sizes(dir, total_files, total_size);
+
 	total_size = 0;
 }
 
+/* amortized cleanup of one cache subdir, for when a compile has taken
+   it over its limits. Rather than rescanning the whole subdir, the
+   subdirs within it are cleaned one at a time down to their share of
+   the limits until the whole is back within them. The first one is
+   picked by pid so that parallel compiles tend to clean different
+   parts of the cache */
+void cleanup_incremental(const char *dir, unsigned counters[STATS_END])
+{
+	size_t maxfiles = counters[STATS_MAXFILES];
+	size_t maxsize = counters[STATS_MAXSIZE];
+	size_t files_done = 0, size_done = 0;
+	size_t files_left = 0, size_left = 0;
+	int start = getpid() & 0xF;
+	int i, found = 0;
+
+	for (i=0;i<=0xF;i++) {
+		struct stat st;
+		char *sdir;
+
+		x_asprintf(&sdir, "%s/%1x", dir, (start + i) & 0xF);
+		if (stat(sdir, &st) != 0 || !S_ISDIR(st.st_mode)) {
+			free(sdir);
+			continue;
+		}
+		found = 1;
+
+		/* a zero threshold means no limit */
+		size_threshold = maxsize * LIMIT_MULTIPLE / 16;
+		files_threshold = maxfiles * LIMIT_MULTIPLE / 16;
+		if (maxsize && !size_threshold) size_threshold = 1;
+		if (maxfiles && !files_threshold) files_threshold = 1;
+
+		clean_dir(sdir);
+		free(sdir);
+
+		files_done += removed_files;
+		size_done += removed_size;
+		files_left += total_files;
+		size_left += total_size;
+		total_size = 0;
+
+		if ((maxfiles == 0 || counters[STATS_NUMFILES] <= maxfiles + files_done) &&
+		    (maxsize == 0 || counters[STATS_TOTALSIZE] <= maxsize + size_done)) {
+			break;
+		}
+	}
+
+	if (!found) {
+		/* the files are not in subdirs with CCACHE_NLEVELS=1 */
+		cleanup_dir(dir, maxfiles, maxsize);
+	} else if (i >= 0xF) {
+		/* everything has been scanned, so the real sizes are known */
+		stats_set_sizes(dir, files_left, size_left);
+	} else {
+		stats_remove_files(dir, files_done, size_done);
+	}
+}
+
 /* cleanup in all cache subdirs */
 void cleanup_all(const char *dir)
 {
@@ -161,16 +235,9 @@ void cleanup_all(const char *dir)
 /* traverse function for wiping files */
 static void wipe_fn(const char *fname, struct stat *st)
 {
-	char *p;
-
 	if (!S_ISREG(st->st_mode)) return;
 
-	p = str_basename(fname);
-	if (strcmp(p, "stats") == 0) {
-		free(p);
-		return;
-	}
-	free(p);
+	if (is_stats_file(fname)) return;
 
 	unlink(fname);
 }
@@ -184,7 +251,7 @@ void wipe_all(const char *dir)
 	
 	for (i=0;i<=0xF;i++) {
 		x_asprintf(&dname, "%s/%1x", dir, i);
-		traverse(dir, wipe_fn);
+		traverse(dname, wipe_fn);
 		free(dname);
 	}
 
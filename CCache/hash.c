@@ -16,21 +16,62 @@
    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
 */
 /*
-  simple front-end functions to mdfour code
+  simple front-end functions to the hash code. The hash is MurmurHash3 by
+  default, or md4 (as used by earlier versions) if CCACHE_HASH=md4 is set
 */
 
 #include "ccache.h"
 
 static struct mdfour md;
+static struct murmur3 mm;
+static int use_md4 = -1;
+
+/* is the md4 hash selected? */
+static int hash_md4(void)
+{
+	if (use_md4 == -1) {
+		char *e = getenv("CCACHE_HASH");
+		use_md4 = 0;
+		if (e) {
+			if (strcmp(e, "md4") == 0) {
+				use_md4 = 1;
+			} else if (strcmp(e, "murmur3") != 0) {
+				cc_log("unknown CCACHE_HASH %s - using murmur3\n", e);
+			}
+		}
+	}
+	return use_md4;
+}
+
+/* form the printable result. The size is included to reduce the chance
+   of collisions, and results of the non md4 hash are marked so that the
+   hash in use is recorded in the names of the cache files */
+static void hash_format(char *ret, const unsigned char *sum, unsigned totalN, int md4)
+{
+	int i;
+
+	for (i=0;i<16;i++) {
+		sprintf(&ret[i*2], "%02x", (unsigned)sum[i]);
+	}
+	sprintf(&ret[i*2], md4 ? "-%u" : "-%u-m3", totalN);
+}
 
 void hash_buffer(const char *s, int len)
 {
-	mdfour_update(&md, (unsigned char *)s, len);
+	if (hash_md4()) {
+		mdfour_update(&md, (unsigned char *)s, len);
+	} else if (s) {
+		murmur3_update(&mm, (unsigned char *)s, len);
+	}
 }
 
 void hash_start(void)
 {
-	mdfour_begin(&md);
+	if (hash_md4()) {
+		mdfour_begin(&md);
+	} else {
+		murmur3_begin(&mm);
+	}
 }
 
 void hash_string(const char *s)
@@ -46,7 +87,7 @@ void hash_int(int x)
 /* add contents of a file to the hash */
 void hash_file(const char *fname)
 {
-	char buf[1024];
+	char buf[16384];
 	int fd, n;
 
 	fd = open(fname, O_RDONLY|O_BINARY);
@@ -66,15 +107,62 @@ char *hash_result(void)
 {
 	unsigned char sum[16];
 	static char ret[53];
-	int i;
 
-	hash_buffer(NULL, 0);
-	mdfour_result(&md, sum);
-	
-	for (i=0;i<16;i++) {
-		sprintf(&ret[i*2], "%02x", (unsigned)sum[i]);
+	if (hash_md4()) {
+		hash_buffer(NULL, 0);
+		mdfour_result(&md, sum);
+		hash_format(ret, sum, md.totalN, 1);
+	} else {
+		murmur3_result(&mm, sum);
+		hash_format(ret, sum, mm.totalN, 0);
+	}
+
+	return ret;
+}
+
+/* return the hash of the contents of a single file as a malloced string,
+   or NULL if the file cannot be read. The running hash is not affected */
+char *hash_file_digest(const char *fname)
+{
+	struct mdfour md1;
+	struct murmur3 mm1;
+	unsigned char sum[16];
+	char buf[16384];
+	char *ret;
+	int fd, n;
+	int md4 = hash_md4();
+
+	fd = open(fname, O_RDONLY|O_BINARY);
+	if (fd == -1) {
+		return NULL;
+	}
+
+	if (md4) {
+		mdfour_begin(&md1);
+	} else {
+		murmur3_begin(&mm1);
+	}
+	while ((n = read(fd, buf, sizeof(buf))) > 0) {
+		if (md4) {
+			mdfour_update(&md1, (unsigned char *)buf, n);
+		} else {
+			murmur3_update(&mm1, (unsigned char *)buf, n);
+		}
+	}
+	close(fd);
+	if (n == -1) {
+		return NULL;
+	}
+
+	ret = x_malloc(53);
+	if (md4) {
+		mdfour_update(&md1, NULL, 0);
+		mdfour_result(&md1, sum);
+		hash_format(ret, sum, md1.totalN, 1);
+	} else {
+		murmur3_result(&mm1, sum);
+		hash_format(ret, sum, mm1.totalN, 0);
 	}
-	sprintf(&ret[i*2], "-%u", (unsigned)md.totalN);
 
 	return ret;
 }
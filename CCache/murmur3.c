@@ -0,0 +1,176 @@
+/*
+   an incremental implementation of the 128 bit x86 variant of
+   MurmurHash3, a fast non-cryptographic hash
+
+   MurmurHash3 was written by Austin Appleby, who has placed it in the
+   public domain.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+   
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+   
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+#include "ccache.h"
+
+/* only 32 bit arithmetic is used, so uint32 must not be wider */
+#define ROTL32(x, r) ((uint32)(((x) << (r)) | ((x) >> (32 - (r)))))
+
+#define C1 0x239b961bU
+#define C2 0xab0e9789U
+#define C3 0x38b34ae5U
+#define C4 0xa1e38b93U
+
+/* read a little endian word, whatever the byte order of the host */
+static uint32 getblock(const unsigned char *p)
+{
+	return (uint32)p[0] | ((uint32)p[1] << 8) |
+		((uint32)p[2] << 16) | ((uint32)p[3] << 24);
+}
+
+static uint32 fmix32(uint32 h)
+{
+	h ^= h >> 16;
+	h *= 0x85ebca6bU;
+	h ^= h >> 13;
+	h *= 0xc2b2ae35U;
+	h ^= h >> 16;
+	return h;
+}
+
+/* process one 16 byte block */
+static void murmur3_block(struct murmur3 *mm, const unsigned char *in)
+{
+	uint32 k1 = getblock(in);
+	uint32 k2 = getblock(in + 4);
+	uint32 k3 = getblock(in + 8);
+	uint32 k4 = getblock(in + 12);
+
+	k1 *= C1; k1 = ROTL32(k1, 15); k1 *= C2; mm->h1 ^= k1;
+	mm->h1 = ROTL32(mm->h1, 19); mm->h1 += mm->h2; mm->h1 = mm->h1*5 + 0x561ccd1bU;
+
+	k2 *= C2; k2 = ROTL32(k2, 16); k2 *= C3; mm->h2 ^= k2;
+	mm->h2 = ROTL32(mm->h2, 17); mm->h2 += mm->h3; mm->h2 = mm->h2*5 + 0x0bcaa747U;
+
+	k3 *= C3; k3 = ROTL32(k3, 17); k3 *= C4; mm->h3 ^= k3;
+	mm->h3 = ROTL32(mm->h3, 15); mm->h3 += mm->h4; mm->h3 = mm->h3*5 + 0x96cd1c35U;
+
+	k4 *= C4; k4 = ROTL32(k4, 18); k4 *= C1; mm->h4 ^= k4;
+	mm->h4 = ROTL32(mm->h4, 13); mm->h4 += mm->h1; mm->h4 = mm->h4*5 + 0x32ac3b17U;
+}
+
+void murmur3_begin(struct murmur3 *mm)
+{
+	mm->h1 = mm->h2 = mm->h3 = mm->h4 = 0;
+	mm->totalN = 0;
+	mm->tail_len = 0;
+}
+
+void murmur3_update(struct murmur3 *mm, const unsigned char *in, int n)
+{
+	mm->totalN += n;
+
+	if (mm->tail_len) {
+		int len = 16 - mm->tail_len;
+		if (len > n) len = n;
+		memcpy(mm->tail + mm->tail_len, in, len);
+		mm->tail_len += len;
+		n -= len;
+		in += len;
+		if (mm->tail_len < 16) {
+			return;
+		}
+		murmur3_block(mm, mm->tail);
+		mm->tail_len = 0;
+	}
+
+	while (n >= 16) {
+		murmur3_block(mm, in);
+		in += 16;
+		n -= 16;
+	}
+
+	if (n) {
+		memcpy(mm->tail, in, n);
+		mm->tail_len = n;
+	}
+}
+
+/* finish the hash, giving a 16 byte result. Further updates are not
+   possible afterwards */
+void murmur3_result(struct murmur3 *mm, unsigned char *out)
+{
+	const unsigned char *tail = mm->tail;
+	uint32 k1 = 0, k2 = 0, k3 = 0, k4 = 0;
+	uint32 h[4];
+	int i;
+
+	switch (mm->tail_len) {
+	case 15: k4 ^= (uint32)tail[14] << 16;
+		/* fall through */
+	case 14: k4 ^= (uint32)tail[13] << 8;
+		/* fall through */
+	case 13: k4 ^= (uint32)tail[12];
+		k4 *= C4; k4 = ROTL32(k4, 18); k4 *= C1; mm->h4 ^= k4;
+		/* fall through */
+	case 12: k3 ^= (uint32)tail[11] << 24;
+		/* fall through */
+	case 11: k3 ^= (uint32)tail[10] << 16;
+		/* fall through */
+	case 10: k3 ^= (uint32)tail[9] << 8;
+		/* fall through */
+	case 9: k3 ^= (uint32)tail[8];
+		k3 *= C3; k3 = ROTL32(k3, 17); k3 *= C4; mm->h3 ^= k3;
+		/* fall through */
+	case 8: k2 ^= (uint32)tail[7] << 24;
+		/* fall through */
+	case 7: k2 ^= (uint32)tail[6] << 16;
+		/* fall through */
+	case 6: k2 ^= (uint32)tail[5] << 8;
+		/* fall through */
+	case 5: k2 ^= (uint32)tail[4];
+		k2 *= C2; k2 = ROTL32(k2, 16); k2 *= C3; mm->h2 ^= k2;
+		/* fall through */
+	case 4: k1 ^= (uint32)tail[3] << 24;
+		/* fall through */
+	case 3: k1 ^= (uint32)tail[2] << 16;
+		/* fall through */
+	case 2: k1 ^= (uint32)tail[1] << 8;
+		/* fall through */
+	case 1: k1 ^= (uint32)tail[0];
+		k1 *= C1; k1 = ROTL32(k1, 15); k1 *= C2; mm->h1 ^= k1;
+	}
+	mm->tail_len = 0;
+
+	mm->h1 ^= mm->totalN; mm->h2 ^= mm->totalN;
+	mm->h3 ^= mm->totalN; mm->h4 ^= mm->totalN;
+
+	mm->h1 += mm->h2; mm->h1 += mm->h3; mm->h1 += mm->h4;
+	mm->h2 += mm->h1; mm->h3 += mm->h1; mm->h4 += mm->h1;
+
+	mm->h1 = fmix32(mm->h1);
+	mm->h2 = fmix32(mm->h2);
+	mm->h3 = fmix32(mm->h3);
+	mm->h4 = fmix32(mm->h4);
+
+	mm->h1 += mm->h2; mm->h1 += mm->h3; mm->h1 += mm->h4;
+	mm->h2 += mm->h1; mm->h3 += mm->h1; mm->h4 += mm->h1;
+
+	/* the same byte order as the reference on a little endian host */
+	h[0] = mm->h1; h[1] = mm->h2; h[2] = mm->h3; h[3] = mm->h4;
+	for (i=0;i<4;i++) {
+		out[i*4] = h[i] & 0xFF;
+		out[i*4+1] = (h[i]>>8) & 0xFF;
+		out[i*4+2] = (h[i]>>16) & 0xFF;
+		out[i*4+3] = (h[i]>>24) & 0xFF;
+	}
+}
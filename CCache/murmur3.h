@@ -0,0 +1,32 @@
+/*
+   an incremental implementation of the 128 bit x86 variant of
+   MurmurHash3, a fast non-cryptographic hash
+
+   MurmurHash3 was written by Austin Appleby, who has placed it in the
+   public domain.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+   
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+   
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+struct murmur3 {
+	uint32 h1, h2, h3, h4;
+	uint32 totalN;
+	unsigned char tail[16];
+	unsigned tail_len;
+};
+
+void murmur3_begin(struct murmur3 *mm);
+void murmur3_update(struct murmur3 *mm, const unsigned char *in, int n);
+void murmur3_result(struct murmur3 *mm, unsigned char *out);
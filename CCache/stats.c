@@ -32,6 +32,12 @@ extern char *cache_dir;
 #define FLAG_NOZERO 1 /* don't zero with the -z option */
 #define FLAG_ALWAYS 2 /* always show, even if zero */
 
+/* the journal of updates is folded into the stats file once
+   JOURNAL_FOLD bytes have been appended since the last fold, and
+   truncated once it has been folded beyond JOURNAL_MAX bytes */
+#define JOURNAL_FOLD 1024
+#define JOURNAL_MAX (64*1024)
+
 static struct {
 	enum stats stat;
 	char *message;
@@ -39,6 +45,7 @@ static struct {
 	unsigned flags;
 } stats_info[] = {
 	{ STATS_CACHED,       "cache hit                      ", NULL, FLAG_ALWAYS },
+	{ STATS_DIRECT,       "direct mode hit                ", NULL, FLAG_ALWAYS },
 	{ STATS_TOCACHE,      "cache miss                     ", NULL, FLAG_ALWAYS },
 	{ STATS_LINK,         "called for link                ", NULL, 0 },
 	{ STATS_MULTIPLE,     "multiple source files          ", NULL, 0 },
@@ -116,22 +123,201 @@ static void stats_read_fd(int fd, unsigned counters[STATS_END])
 	parse_stats(counters, buf);
 }
 
-/* update the stats counter for this compile */
-static void stats_update_size(enum stats stat, size_t size, size_t numfiles)
+/* add a signed amount to a counter, not going below zero */
+static unsigned add_delta(unsigned v, long delta)
+{
+	if (delta < 0 && (unsigned long)-delta > v) {
+		return 0;
+	}
+	return v + delta;
+}
+
+/* add the complete records in the journal of a stats file beyond the
+   folded position to the counters. Returns the position after them */
+static unsigned journal_read(const char *fname, unsigned counters[STATS_END])
+{
+	char *jname;
+	char *buf, *p, *end;
+	unsigned pos = counters[STATS_JOURNAL];
+	struct stat st;
+	int fd, n;
+
+	x_asprintf(&jname, "%s.journal", fname);
+	fd = open(jname, O_RDONLY|O_BINARY);
+	free(jname);
+	if (fd == -1) {
+		return 0;
+	}
+	if (fstat(fd, &st) != 0) {
+		close(fd);
+		return pos;
+	}
+
+	/* the journal has been truncated since it was last folded */
+	if ((size_t)st.st_size < pos) {
+		pos = 0;
+	}
+	if ((size_t)st.st_size == pos || lseek(fd, pos, SEEK_SET) != (off_t)pos) {
+		close(fd);
+		return pos;
+	}
+
+	buf = x_malloc(st.st_size - pos + 1);
+	n = read(fd, buf, st.st_size - pos);
+	close(fd);
+	if (n <= 0) {
+		free(buf);
+		return pos;
+	}
+	buf[n] = 0;
+
+	for (p = buf; (end = strchr(p, '\n')); p = end + 1) {
+		long stat, numfiles, size;
+		*end = 0;
+		if (sscanf(p, "%ld %ld %ld", &stat, &size, &numfiles) != 3) {
+			continue;
+		}
+		if (stat > STATS_NONE && stat < STATS_END) {
+			counters[stat]++;
+		}
+		counters[STATS_NUMFILES] = add_delta(counters[STATS_NUMFILES], numfiles);
+		counters[STATS_TOTALSIZE] = add_delta(counters[STATS_TOTALSIZE], size);
+	}
+	pos += p - buf;
+	free(buf);
+
+	return pos;
+}
+
+/* fold the journal into the counters of a locked stats file */
+static void journal_fold(const char *fname, unsigned counters[STATS_END])
+{
+#ifndef _WIN32
+	counters[STATS_JOURNAL] = journal_read(fname, counters);
+
+	if (counters[STATS_JOURNAL] >= JOURNAL_MAX) {
+		char *jname;
+		struct stat st;
+		int fd;
+
+		/* an update appended between the size check and the
+		   truncation is lost, which is rare enough not to matter for
+		   these counters - a full cleanup recounts the files anyway */
+		x_asprintf(&jname, "%s.journal", fname);
+		fd = open(jname, O_WRONLY|O_BINARY);
+		free(jname);
+		if (fd != -1) {
+			if (fstat(fd, &st) == 0 &&
+			    (size_t)st.st_size == counters[STATS_JOURNAL] &&
+			    ftruncate(fd, 0) == 0) {
+				counters[STATS_JOURNAL] = 0;
+			}
+			close(fd);
+		}
+	}
+#else
+	(void)fname;
+	(void)counters;
+#endif
+}
+
+#ifndef _WIN32
+/* append an update to the journal of a stats file. No lock is needed as
+   a small append is atomic on local filesystems. Returns the size of the
+   journal afterwards, or -1 if the update could not be appended */
+static long journal_append(const char *fname, enum stats stat, long size, long numfiles)
+{
+	char *jname;
+	char buf[64];
+	struct stat st;
+	long ret = -1;
+	int fd, len;
+
+	x_asprintf(&jname, "%s.journal", fname);
+	fd = open(jname, O_WRONLY|O_APPEND|O_CREAT|O_BINARY, 0666);
+	free(jname);
+	if (fd == -1) {
+		return -1;
+	}
+
+	len = snprintf(buf, sizeof(buf), "%d %ld %ld\n", (int)stat, size, numfiles);
+	if (write(fd, buf, len) == len && fstat(fd, &st) == 0) {
+		ret = st.st_size;
+	}
+	close(fd);
+
+	return ret;
+}
+
+/* read the counters of a stats file without taking the lock. A fold
+   rewrites them with a single small write, so this is good enough for
+   deciding whether to fold or clean up */
+static void stats_peek(const char *fname, unsigned counters[STATS_END])
 {
 	int fd;
-	unsigned counters[STATS_END];
-	int need_cleanup = 0;
 
-	if (getenv("CCACHE_NOSTATS")) return;
+	fd = open(fname, O_RDONLY|O_BINARY);
+	if (fd == -1) {
+		stats_default(counters);
+		return;
+	}
+	stats_read_fd(fd, counters);
+	close(fd);
+}
+#endif
 
-	if (!stats_file) {
-		if (!cache_dir) return;
-		x_asprintf(&stats_file, "%s/stats", cache_dir);
+/* see if the counters of a stats file are over its limits */
+static int stats_over_limits(unsigned counters[STATS_END])
+{
+	if (counters[STATS_MAXFILES] != 0 &&
+	    counters[STATS_NUMFILES] > counters[STATS_MAXFILES]) {
+		return 1;
+	}
+	if (counters[STATS_MAXSIZE] != 0 &&
+	    counters[STATS_TOTALSIZE] > counters[STATS_MAXSIZE]) {
+		return 1;
 	}
+	return 0;
+}
+
+/* record an update in a stats file. Usually it is just appended to the
+   journal and the limits checked without taking the lock; only once
+   the journal has grown or a cleanup is due is it folded into the
+   stats file under the lock. This keeps parallel compiles from
+   queueing on the lock */
+static void stats_record(const char *fname, enum stats stat, long size, long numfiles, int cleanup)
+{
+	int fd;
+	unsigned counters[STATS_END];
+	int journaled = 0;
+
+#ifndef _WIN32
+	{
+		long journal_size = journal_append(fname, stat, size, numfiles);
+		if (journal_size != -1) {
+			long pending;
+
+			memset(counters, 0, sizeof(counters));
+			stats_peek(fname, counters);
+
+			/* only the records past the folded position count, the
+			   journal itself is kept until it reaches JOURNAL_MAX */
+			pending = journal_size - (long)counters[STATS_JOURNAL];
+			if (pending < 0) {
+				pending = journal_size;
+			}
+			if (pending < JOURNAL_FOLD) {
+				if (!cleanup) return;
+				journal_read(fname, counters);
+				if (!stats_over_limits(counters)) return;
+			}
+			journaled = 1;
+		}
+	}
+#endif
 
 	/* open safely to try to prevent symlink races */
-	fd = safe_open(stats_file);
+	fd = safe_open(fname);
 
 	/* still can't get it? don't bother ... */
 	if (fd == -1) return;
@@ -142,14 +328,15 @@ static void stats_update_size(enum stats stat, size_t size, size_t numfiles)
 
 	/* read in the old stats */
 	stats_read_fd(fd, counters);
+	journal_fold(fname, counters);
 
 	/* update them */
-	counters[stat]++;
-
-	/* on a cache miss we up the file count and size */
-	if (stat == STATS_TOCACHE) {
-		counters[STATS_NUMFILES] += numfiles;
-		counters[STATS_TOTALSIZE] += size;
+	if (!journaled) {
+		if (stat != STATS_NONE) {
+			counters[stat]++;
+		}
+		counters[STATS_NUMFILES] = add_delta(counters[STATS_NUMFILES], numfiles);
+		counters[STATS_TOTALSIZE] = add_delta(counters[STATS_TOTALSIZE], size);
 	}
 
 	/* and write them out */
@@ -157,20 +344,24 @@ static void stats_update_size(enum stats stat, size_t size, size_t numfiles)
 	close(fd);
 
 	/* we might need to cleanup if the cache has now got too big */
-	if (counters[STATS_MAXFILES] != 0 &&
-	    counters[STATS_NUMFILES] > counters[STATS_MAXFILES]) {
-		need_cleanup = 1;
-	}
-	if (counters[STATS_MAXSIZE] != 0 &&
-	    counters[STATS_TOTALSIZE] > counters[STATS_MAXSIZE]) {
-		need_cleanup = 1;
+	if (cleanup && stats_over_limits(counters)) {
+		char *p = dirname((char *)fname);
+		cleanup_incremental(p, counters);
+		free(p);
 	}
+}
 
-	if (need_cleanup) {
-		char *p = dirname(stats_file);
-		cleanup_dir(p, counters[STATS_MAXFILES], counters[STATS_MAXSIZE]);
-		free(p);
+/* update the stats counter for this compile */
+static void stats_update_size(enum stats stat, size_t size, size_t numfiles)
+{
+	if (getenv("CCACHE_NOSTATS")) return;
+
+	if (!stats_file) {
+		if (!cache_dir) return;
+		x_asprintf(&stats_file, "%s/stats", cache_dir);
 	}
+
+	stats_record(stats_file, stat, size, numfiles, 1);
 }
 
 /* record a cache miss */
@@ -188,19 +379,40 @@ void stats_update(enum stats stat)
 	stats_update_size(stat, 0, 0);
 }
 
+/* record files removed from a cache dir by a cleanup */
+void stats_remove_files(const char *dir, size_t num_files, size_t total_size)
+{
+	char *fname;
+
+	x_asprintf(&fname, "%s/stats", dir);
+	stats_record(fname, STATS_NONE, -(long)total_size, -(long)num_files, 0);
+	free(fname);
+}
+
 /* read in the stats from one dir and add to the counters */
 void stats_read(const char *stats_file, unsigned counters[STATS_END])
 {
-	int fd;
+	int fd, i;
+	unsigned dir_counters[STATS_END];
+
+	memset(dir_counters, 0, sizeof(dir_counters));
 
 	fd = open(stats_file, O_RDONLY|O_BINARY);
 	if (fd == -1) {
-		stats_default(counters);
-		return;
+		stats_default(dir_counters);
+	} else {
+		lock_fd(fd);
+		stats_read_fd(fd, dir_counters);
+		close(fd);
+	}
+
+	/* include the updates not yet folded in */
+	journal_read(stats_file, dir_counters);
+	dir_counters[STATS_JOURNAL] = 0;
+
+	for (i=0;i<STATS_END;i++) {
+		counters[i] += dir_counters[i];
 	}
-	lock_fd(fd);
-	stats_read_fd(fd, counters);
-	close(fd);
 }
 
 /* sum and display the total stats for all cache dirs */
@@ -263,6 +475,9 @@ void stats_zero(void)
 	x_asprintf(&fname, "%s/stats", cache_dir);
 	unlink(fname);
 	free(fname);
+	x_asprintf(&fname, "%s/stats.journal", cache_dir);
+	unlink(fname);
+	free(fname);
 
 	for (dir=0;dir<=0xF;dir++) {
 		x_asprintf(&fname, "%s/%1x/stats", cache_dir, dir);
@@ -274,6 +489,7 @@ void stats_zero(void)
 		memset(counters, 0, sizeof(counters));
 		lock_fd(fd);
 		stats_read_fd(fd, counters);
+		journal_fold(fname, counters);
 		for (i=0;stats_info[i].message;i++) {
 			if (!(stats_info[i].flags & FLAG_NOZERO)) {
 				counters[stats_info[i].stat] = 0;
@@ -320,6 +536,7 @@ int stats_set_limits(long maxfiles, long maxsize)
 		if (fd != -1) {
 			lock_fd(fd);
 			stats_read_fd(fd, counters);
+			journal_fold(fname, counters);
 			if (maxfiles != -1) {
 				counters[STATS_MAXFILES] = maxfiles;
 			}
@@ -351,6 +568,7 @@ void stats_set_sizes(const char *dir, size_t num_files, size_t total_size)
 	if (fd != -1) {
 		lock_fd(fd);
 		stats_read_fd(fd, counters);
+		journal_fold(stats_file, counters);
 		counters[STATS_NUMFILES] = num_files;
 		counters[STATS_TOTALSIZE] = total_size;
 		write_stats(fd, counters);
@@ -264,6 +264,29 @@ basetests() {
     checkstat 'cache hit' 11
     checkstat 'cache miss' 39
 
+    testname="stats journal"
+    # cached compiles append to the stats journal, only now and then is
+    # it folded into the stats file under the lock
+    $CCACHE_COMPILE -c test1.c
+    journal=`ls -t "$CCACHE_DIR"/*/stats.journal | head -1`
+    stats=`echo "$journal" | sed 's/\.journal$//'`
+    last=`cksum < "$stats"`
+    folds=0
+    i=0
+    while [ $i -lt 400 ]; do
+	$CCACHE_COMPILE -c test1.c
+	sum=`cksum < "$stats"`
+	if [ "$sum" != "$last" ]; then
+	    folds=`expr $folds + 1`
+	    last="$sum"
+	fi
+	i=`expr $i + 1`
+    done
+    checkstat 'cache hit' 412
+    if [ $folds -gt 10 ]; then
+	test_failed "SUITE: $testsuite TEST: $testname - stats file rewritten $folds times in 400 cached compiles"
+    fi
+
     testname="zero-stats"
     $CCACHE -z > /dev/null
     checkstat 'cache hit' 0
@@ -292,7 +315,7 @@ swigtests() {
     checkstat 'cache hit' 0
     checkstat 'cache miss' 1
     
-    checkstat 'files in cache' 6
+    checkstat 'files in cache' 7
 
     testname="BASIC2"
     $CCACHE_COMPILE -java testswig1.i
@@ -348,10 +371,10 @@ swigtests() {
     checkstat 'cache hit' 3 
     checkstat 'cache miss' 4
 
-    # strictly speaking should be 3x6=18 instead of 4x6=24 - RECACHE causes a double counting!
-    checkstat 'files in cache' 24 
+    # strictly speaking should be 3x6+3=21 instead of 4x6+3=27 - RECACHE causes a double counting!
+    checkstat 'files in cache' 27 
     $CCACHE -c > /dev/null
-    checkstat 'files in cache' 18
+    checkstat 'files in cache' 21
 
 
     testname="CCACHE_HASHDIR"
@@ -363,7 +386,7 @@ swigtests() {
     checkstat 'cache hit' 4
     checkstat 'cache miss' 5
 
-    checkstat 'files in cache' 24
+    checkstat 'files in cache' 28
     
     testname="cpp call"
     $CCACHE_COMPILE -java -E testswig1.i > testswig1-preproc.i
@@ -393,8 +416,46 @@ swigtests() {
     checkstat 'cache hit' 7
     checkstat 'cache miss' 7
 
+    testname="direct mode"
+    genswigcode testswig2.i 2
+    echo '%include "testswig2inc.i"' >> testswig2.i
+    echo 'int direct1(int x);' > testswig2inc.i
+    $CCACHE_COMPILE -java testswig2.i
+    checkstat 'cache hit' 7
+    checkstat 'cache miss' 8
+    direct=`getstat 'direct mode hit'`
+
+    $CCACHE_COMPILE -java testswig2.i
+    checkstat 'cache hit' 8
+    checkstat 'cache miss' 8
+    checkstat 'direct mode hit' `expr $direct + 1`
+
+    echo 'int direct2(int x);' >> testswig2inc.i
+    $CCACHE_COMPILE -java testswig2.i
+    checkstat 'cache hit' 8
+    checkstat 'cache miss' 9
+
+    $CCACHE_COMPILE -java testswig2.i
+    checkstat 'cache hit' 9
+    checkstat 'cache miss' 9
+    checkstat 'direct mode hit' `expr $direct + 2`
+
+    testname="CCACHE_NODIRECT"
+    CCACHE_NODIRECT=1 $CCACHE_COMPILE -java testswig2.i
+    checkstat 'cache hit' 10
+    checkstat 'cache miss' 9
+    checkstat 'direct mode hit' `expr $direct + 2`
+
+    testname="CCACHE_HASH"
+    CCACHE_HASH=md4 CCACHE_NODIRECT=1 $CCACHE_COMPILE -java testswig2.i
+    checkstat 'cache hit' 10
+    checkstat 'cache miss' 10
+    CCACHE_HASH=md4 CCACHE_NODIRECT=1 $CCACHE_COMPILE -java testswig2.i
+    checkstat 'cache hit' 11
+    checkstat 'cache miss' 10
+
     rm -f testswig1-preproc.i
-    rm -f testswig1.i
+    rm -f testswig1.i testswig2.i testswig2inc.i
 }
 
 ######
@@ -0,0 +1,36 @@
+%module Simple
+
+// Each function is wrapped twice, the *_fast versions use the csblittable feature.
+// All the functions have an %exception handler as is common in real modules.
+
+%exception %{
+  try {
+    $action
+  } catch (std::exception &e) {
+    SWIG_CSharpSetPendingException(SWIG_CSharpApplicationException, e.what());
+    return $null;
+  }
+%}
+
+%csblittable add_fast;
+%csblittable Point::distance_fast;
+%csblittable Point::move_fast;
+
+%inline %{
+#include <exception>
+#include <math.h>
+
+int add(int a, int b) throw() { return a + b; }
+int add_fast(int a, int b) throw() { return a + b; }
+
+struct Point {
+  double x, y;
+  Point(double x, double y) : x(x), y(y) {}
+
+  double distance(const Point *p) const throw() { return sqrt((x - p->x)*(x - p->x) + (y - p->y)*(y - p->y)); }
+  double distance_fast(const Point *p) const throw() { return sqrt((x - p->x)*(x - p->x) + (y - p->y)*(y - p->y)); }
+
+  void move(double dx, double dy) throw() { x += dx; y += dy; }
+  void move_fast(double dx, double dy) throw() { x += dx; y += dy; }
+};
+%}
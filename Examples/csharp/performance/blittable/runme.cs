@@ -0,0 +1,42 @@
+// Compares calls through the default P/Invoke declarations against the
+// declarations generated with the csblittable feature. Each case is run a
+// number of times to warm up the JIT before the timed iterations.
+
+using System;
+using System.Diagnostics;
+
+public class runme {
+  const int ITERATIONS = 10000000;
+
+  delegate void Benchmark();
+
+  static void measure(string name, Benchmark b) {
+    for (int i=0; i<ITERATIONS/10; i++)
+      b();
+    Stopwatch watch = Stopwatch.StartNew();
+    for (int i=0; i<ITERATIONS; i++)
+      b();
+    watch.Stop();
+    double ns = watch.Elapsed.TotalMilliseconds * 1e6 / ITERATIONS;
+    Console.WriteLine(String.Format("{0,-16} {1,10:F2} ns/call", name, ns));
+  }
+
+  static void Main() {
+    Point p = new Point(1.0, 2.0);
+    Point q = new Point(4.0, 6.0);
+    int isum = 0;
+    double dsum = 0.0;
+
+    measure("add", delegate { isum = Simple.add(isum, 1); });
+    measure("add fast", delegate { isum = Simple.add_fast(isum, 1); });
+
+    measure("distance", delegate { dsum += p.distance(q); });
+    measure("distance fast", delegate { dsum += p.distance_fast(q); });
+
+    measure("move", delegate { p.move(0.5, -0.5); });
+    measure("move fast", delegate { p.move_fast(-0.5, 0.5); });
+
+    if (Simple.add(2, 3) != Simple.add_fast(2, 3) || p.distance(q) != p.distance_fast(q))
+      throw new Exception("results differ");
+  }
+}
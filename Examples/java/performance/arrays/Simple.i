@@ -0,0 +1,48 @@
+%module Simple
+
+%include <arrays_java.i>
+%include <arrays_nocopy.i>
+
+%apply (const double *CRITICAL, size_t LENGTH) { (const double *critical, size_t n) }
+%apply (double *CRITICAL, size_t LENGTH) { (double *critical, size_t n) }
+%apply (const double *REGION, size_t LENGTH) { (const double *region, size_t n) }
+%apply (double *REGION, size_t LENGTH) { (double *region, size_t n) }
+%apply (double *DIRECT, size_t LENGTH) { (double *direct, size_t n) }
+%apply (const float *CRITICAL, size_t LENGTH) { (const float *critical, size_t n) }
+%apply (const float *REGION, size_t LENGTH) { (const float *region, size_t n) }
+%apply (float *DIRECT, size_t LENGTH) { (float *direct, size_t n) }
+
+%{
+#include <stddef.h>
+
+template<typename T> double sum(const T *values, size_t n) {
+  double total = 0;
+  for (size_t i = 0; i < n; ++i)
+    total += values[i];
+  return total;
+}
+
+void scale(double *values, size_t n, double factor) {
+  for (size_t i = 0; i < n; ++i)
+    values[i] *= factor;
+}
+%}
+
+%inline %{
+/* arrays_java.i copies the whole array in and back out again */
+double sum_copied(double copied[], size_t n) { return sum(copied, n); }
+void scale_copied(double copied[], size_t n, double factor) { scale(copied, n, factor); }
+double sumf_copied(float copied[], size_t n) { return sum(copied, n); }
+
+double sum_critical(const double *critical, size_t n) { return sum(critical, n); }
+void scale_critical(double *critical, size_t n, double factor) { scale(critical, n, factor); }
+double sumf_critical(const float *critical, size_t n) { return sum(critical, n); }
+
+double sum_region(const double *region, size_t n) { return sum(region, n); }
+void scale_region(double *region, size_t n, double factor) { scale(region, n, factor); }
+double sumf_region(const float *region, size_t n) { return sum(region, n); }
+
+double sum_direct(double *direct, size_t n) { return sum(direct, n); }
+void scale_direct(double *direct, size_t n, double factor) { scale(direct, n, factor); }
+double sumf_direct(float *direct, size_t n) { return sum(direct, n); }
+%}
@@ -0,0 +1,70 @@
+// Compares passing large arrays using arrays_java.i against the CRITICAL,
+// REGION and DIRECT typemaps in arrays_nocopy.i. Each case is run a number of
+// times to warm up the JIT before the timed iterations.
+
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.DoubleBuffer;
+import java.nio.FloatBuffer;
+
+public class runme {
+
+  static {
+    try {
+	System.loadLibrary("Simple");
+    } catch (UnsatisfiedLinkError e) {
+      System.err.println("Native code library failed to load. See the chapter on Dynamic Linking Problems in the SWIG Java documentation for help.\n" + e);
+      System.exit(1);
+    }
+  }
+
+  static final int SIZE = 50*1024*1024/8;  // 50 MB of doubles
+  static final int WARMUP = 5;
+  static final int ITERATIONS = 20;
+
+  static abstract class Benchmark {
+    abstract void run();
+  }
+
+  static void measure(String name, Benchmark b) {
+    for (int i=0; i<WARMUP; i++)
+      b.run();
+    long start = System.nanoTime();
+    for (int i=0; i<ITERATIONS; i++)
+      b.run();
+    double ms = (System.nanoTime() - start) / 1e6 / ITERATIONS;
+    System.out.println(String.format("%-16s %10.3f ms/op", name, ms));
+  }
+
+  public static void main(String argv[]) {
+    final double[] darray = new double[SIZE];
+    final float[] farray = new float[SIZE];
+    final DoubleBuffer dbuffer = ByteBuffer.allocateDirect(8*SIZE).order(ByteOrder.nativeOrder()).asDoubleBuffer();
+    final FloatBuffer fbuffer = ByteBuffer.allocateDirect(4*SIZE).order(ByteOrder.nativeOrder()).asFloatBuffer();
+    for (int i=0; i<SIZE; i++) {
+      darray[i] = i;
+      farray[i] = i;
+      dbuffer.put(i, i);
+      fbuffer.put(i, i);
+    }
+
+    measure("sum copied", new Benchmark() { void run() { Simple.sum_copied(darray, SIZE); } });
+    measure("sum critical", new Benchmark() { void run() { Simple.sum_critical(darray); } });
+    measure("sum region", new Benchmark() { void run() { Simple.sum_region(darray); } });
+    measure("sum direct", new Benchmark() { void run() { Simple.sum_direct(dbuffer); } });
+
+    measure("scale copied", new Benchmark() { void run() { Simple.scale_copied(darray, SIZE, 1.0); } });
+    measure("scale critical", new Benchmark() { void run() { Simple.scale_critical(darray, 1.0); } });
+    measure("scale region", new Benchmark() { void run() { Simple.scale_region(darray, 1.0); } });
+    measure("scale direct", new Benchmark() { void run() { Simple.scale_direct(dbuffer, 1.0); } });
+
+    measure("sumf copied", new Benchmark() { void run() { Simple.sumf_copied(farray, SIZE); } });
+    measure("sumf critical", new Benchmark() { void run() { Simple.sumf_critical(farray); } });
+    measure("sumf region", new Benchmark() { void run() { Simple.sumf_region(farray); } });
+    measure("sumf direct", new Benchmark() { void run() { Simple.sumf_direct(fbuffer); } });
+
+    if (Simple.sum_copied(darray, SIZE) != Simple.sum_critical(darray) ||
+        Simple.sum_region(darray) != Simple.sum_direct(dbuffer))
+      throw new RuntimeException("sums differ");
+  }
+}
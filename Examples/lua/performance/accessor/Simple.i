@@ -0,0 +1,14 @@
+%module Simple
+
+%inline %{
+
+class Point {
+public:
+    Point () : x(0), y(0) {}
+    ~Point () {}
+    double x;
+    double y;
+    double getX () const { return x; }
+};
+
+%}
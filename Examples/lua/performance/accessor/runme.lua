@@ -0,0 +1,30 @@
+-- file: runme.lua
+
+-- Cost of the small accessors typically called from scripts:
+-- member variable reads and writes, and a getter method
+
+local harness = require('harness')
+local Simple = harness.load()
+
+local p = Simple.Point()
+local count = 10000000
+
+harness.run("member variable get", count, function(n)
+  local s = 0
+  for i = 1, n do
+    s = s + p.x
+  end
+end)
+
+harness.run("member variable set", count, function(n)
+  for i = 1, n do
+    p.y = i
+  end
+end)
+
+harness.run("getter method call", count, function(n)
+  local s = 0
+  for i = 1, n do
+    s = s + p:getX()
+  end
+end)
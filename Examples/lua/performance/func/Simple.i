@@ -0,0 +1,12 @@
+%module Simple
+
+%inline %{
+
+class MyClass {
+public:
+    MyClass () {}
+    ~MyClass () {}
+    void func () {}
+};
+
+%}
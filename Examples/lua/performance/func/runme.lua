@@ -0,0 +1,13 @@
+-- file: runme.lua
+
+-- Cost of calling a method doing nothing
+
+local harness = require('harness')
+local Simple = harness.load()
+
+local x = Simple.MyClass()
+harness.run("method call", 10000000, function(n)
+  for i = 1, n do
+    x:func()
+  end
+end)
@@ -0,0 +1,26 @@
+-- file: harness.lua
+
+-- Loads the Simple module and times a benchmark function
+
+local harness = {}
+
+function harness.load()
+  if string.sub(_VERSION,1,7)=='Lua 5.0' then
+    -- lua5.0 doesnt have a nice way to do this
+    local lib=loadlib('Simple.dll','luaopen_Simple') or loadlib('Simple.so','luaopen_Simple')
+    assert(lib)()
+    return Simple
+  end
+  -- lua 5.1 does
+  return require('Simple') or Simple
+end
+
+function harness.run(name, count, proc)
+  local t1 = os.clock()
+  proc(count)
+  local t2 = os.clock()
+  print(string.format("%-28s %8.3f seconds (%.1f ns per iteration)",
+                      name, t2 - t1, (t2 - t1) * 1e9 / count))
+end
+
+return harness
@@ -0,0 +1,30 @@
+-- file: runme.lua
+
+-- Cost of calling methods and reading members inherited
+-- through a deep class hierarchy
+
+local harness = require('harness')
+local Simple = harness.load()
+
+local a = Simple.A()
+local h = Simple.H()
+local count = 10000000
+
+harness.run("A method call", count, function(n)
+  for i = 1, n do
+    a:func()
+  end
+end)
+
+harness.run("H inherited method call", count, function(n)
+  for i = 1, n do
+    h:func()
+  end
+end)
+
+harness.run("H inherited member get", count, function(n)
+  local s = 0
+  for i = 1, n do
+    s = s + h.value
+  end
+end)
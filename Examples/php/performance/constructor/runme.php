@@ -0,0 +1,13 @@
+<?php
+
+require "../harness.php";
+
+function proc() {
+  for ($i = 0; $i < 1000000; $i++) {
+    $x = new MyClass();
+  }
+}
+
+run('proc');
+
+?>
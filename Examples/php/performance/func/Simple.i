@@ -0,0 +1,8 @@
+%inline %{
+class MyClass {
+public:
+    MyClass () {}
+    ~MyClass () {}
+    void func () {}
+};
+%}
@@ -0,0 +1,14 @@
+<?php
+
+require "../harness.php";
+
+function proc() {
+  $x = new MyClass();
+  for ($i = 0; $i < 10000000; $i++) {
+    $x->func();
+  }
+}
+
+run('proc');
+
+?>
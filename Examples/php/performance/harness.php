@@ -0,0 +1,18 @@
+<?php
+
+# Times the function $proc with the module named on the command line.  The
+# variants of the module define the same classes, so each one is run in a
+# separate process, see the Makefile.
+function run($proc) {
+  global $argv;
+
+  $module = $argv[1];
+  require "$module.php";
+
+  $t1 = microtime(true);
+  $proc();
+  $t2 = microtime(true);
+  printf("%s took %f seconds\n", $module, $t2 - $t1);
+}
+
+?>
@@ -0,0 +1,16 @@
+# file: runme.tcl
+
+# Cost of dispatching methods and attributes inherited
+# through a deep class hierarchy
+
+catch { load ./Simple[info sharedlibextension] Simple}
+
+set count 1000000
+
+A a
+H h
+
+puts "A method call:        [time {a func} $count]"
+puts "H inherited method:   [time {h func} $count]"
+puts "H inherited cget:     [time {h cget -value} $count]"
+puts "H inherited configure: [time {h configure -value 1} $count]"
@@ -292,6 +292,7 @@ CPP_TEST_CASES += \
 	overload_subtype \
 	overload_template \
 	overload_template_fast \
+	overload_template_tree \
 	pointer_reference \
 	preproc_constants \
 	primitive_ref \
@@ -0,0 +1,70 @@
+using System;
+using System.Reflection;
+using System.Runtime.InteropServices;
+using csharp_blittableNamespace;
+
+public class runme
+{
+  static void Main() 
+  {
+    Thing t1 = new Thing(10);
+    Thing t2 = new Thing(t1);
+    if (t2.get() != 10)
+      throw new Exception("Thing(Thing) failed");
+    if (t1.add(t2) != 20)
+      throw new Exception("add failed");
+    if (t1.addRef(t2) != 20)
+      throw new Exception("addRef failed");
+    if (t1.defaultMethod(t2) != 20)
+      throw new Exception("defaultMethod failed");
+    if (Thing.twice(21) != 42)
+      throw new Exception("twice failed");
+    if (csharp_blittable.sum(1, 2) != 3)
+      throw new Exception("sum failed");
+    if (csharp_blittable.getValue(t1) != 10 || csharp_blittable.getValue(null) != -1)
+      throw new Exception("getValue failed");
+    t1.value = 5;
+    if (t1.value != 5)
+      throw new Exception("member variable failed");
+    csharp_blittable.globalVariable = 20;
+    if (csharp_blittable.globalVariable != 20)
+      throw new Exception("global variable failed");
+
+    // Methods without an empty exception specification still check for pending exceptions
+    try {
+      t1.thrower(-1);
+      throw new Exception("thrower did not throw");
+    } catch (ApplicationException) {
+    }
+    try {
+      csharp_blittable.globalThrower(-1);
+      throw new Exception("globalThrower did not throw");
+    } catch (ApplicationException) {
+    }
+
+    // Null references are still checked
+    try {
+      t1.addRef(null);
+      throw new Exception("addRef did not throw");
+    } catch (ArgumentNullException) {
+    }
+
+    // Check the intermediary class declarations
+    Type imclass = typeof(csharp_blittable).Assembly.GetType("csharp_blittableNamespace.csharp_blittablePINVOKE");
+    checkDeclaration(imclass, "Thing_add", typeof(IntPtr), true);
+    checkDeclaration(imclass, "getValue", typeof(IntPtr), true);
+    checkDeclaration(imclass, "Thing_defaultMethod", typeof(HandleRef), false);
+    checkDeclaration(imclass, "Thing_value_set", typeof(HandleRef), true);
+  }
+
+  static void checkDeclaration(Type imclass, string name, Type firstParameterType, bool suppressed) {
+    MethodInfo method = imclass.GetMethod(name, BindingFlags.Static | BindingFlags.Public | BindingFlags.NonPublic);
+    if (method == null)
+      throw new Exception("No method " + name);
+    if (method.GetParameters()[0].ParameterType != firstParameterType)
+      throw new Exception("Incorrect parameter type for " + name);
+    bool hasAttribute = Attribute.GetCustomAttribute(method, typeof(System.Security.SuppressUnmanagedCodeSecurityAttribute)) != null;
+    if (hasAttribute != suppressed)
+      throw new Exception("Incorrect SuppressUnmanagedCodeSecurity attribute for " + name);
+  }
+}
@@ -82,6 +82,16 @@ public class li_std_vector_runme {
       } catch (ArgumentException) {
       }
     }
+    {
+      // ToArray() test
+      double[] outputarray = vect.ToArray();
+      if (outputarray.Length != collectionSize)
+        throw new Exception("ToArray test size failed");
+      for (int i=0; i<collectionSize; i++) {
+        if (outputarray[i] != vect[i])
+          throw new Exception("ToArray test failed, index:" + i);
+      }
+    }
 #if SWIG_DOTNET_1
     {
       // runtime check that 2D arrays fail
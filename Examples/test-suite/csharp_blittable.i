@@ -0,0 +1,35 @@
+%module csharp_blittable
+
+// Test the csblittable feature
+
+%exception %{
+  try {
+    $action
+  } catch (int i) {
+    SWIG_CSharpSetPendingException(SWIG_CSharpApplicationException, "int exception");
+    return $null;
+  }
+%}
+
+%csblittable;
+%nocsblittable Thing::defaultMethod;
+
+%inline %{
+struct Thing {
+  int value;
+  Thing(int value) : value(value) {}
+  Thing(const Thing *other) : value(other->value) {}
+  ~Thing() {}
+  int get() const throw() { return value; }
+  int add(const Thing *other) const throw() { return value + other->value; }
+  int addRef(const Thing &other) const throw() { return value + other.value; }
+  int defaultMethod(const Thing *other) const throw() { return value + other->value; }
+  static int twice(int i) throw() { return 2*i; }
+  int thrower(int i) const { if (i < 0) throw i; return i; }
+};
+
+int sum(int a, int b) throw() { return a + b; }
+int getValue(const Thing *thing) throw() { return thing ? thing->value : -1; }
+int globalThrower(int i) { if (i < 0) throw i; return i; }
+int globalVariable = 10;
+%}
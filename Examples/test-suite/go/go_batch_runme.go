@@ -0,0 +1,56 @@
+package main
+
+import . "./go_batch"
+
+func main() {
+	args := []AddBatchArgs{{1, 2}, {3, 4}, {5, 6}}
+	results := make([]int, len(args))
+	AddBatch(args, results)
+	for i, a := range args {
+		if results[i] != a.A+a.B {
+			panic("AddBatch")
+		}
+	}
+
+	c := NewCounter()
+	defer DeleteCounter(c)
+	CounterAddBatch([]CounterAddBatchArgs{{c.Swigcptr(), 1}, {c.Swigcptr(), 2}, {c.Swigcptr(), 3}})
+	if c.GetTotal() != 6 {
+		panic("CounterAddBatch")
+	}
+
+	scaled := make([]float64, 2)
+	CounterScaledBatch([]CounterScaledBatchArgs{{c.Swigcptr(), 2, 0.5}, {c.Swigcptr(), 0.5, 1}}, scaled)
+	if scaled[0] != 12.5 || scaled[1] != 4 {
+		panic("CounterScaledBatch")
+	}
+
+	bumps := make([]int, 2)
+	CounterBumpBatch([]CounterBumpBatchArgs{{SMALL}, {LARGE}}, bumps)
+	if bumps[0] != 1 || bumps[1] != 10 {
+		panic("CounterBumpBatch")
+	}
+
+	big := make([]bool, 2)
+	CounterIsBigBatch([]CounterIsBigBatchArgs{{c.Swigcptr(), 5}, {c.Swigcptr(), 10}}, big)
+	if !big[0] || big[1] {
+		panic("CounterIsBigBatch")
+	}
+
+	links := make([]int, 1)
+	CounterLinkBatch([]CounterLinkBatchArgs{{Self: c.Swigcptr(), Arg2: 1, X: 2, Arg4: 3}}, links)
+	if links[0] != 123 {
+		panic("CounterLinkBatch")
+	}
+
+	AddBatch(nil, nil)
+
+	func() {
+		defer func() {
+			if recover() == nil {
+				panic("AddBatch did not panic")
+			}
+		}()
+		AddBatch(args, results[:1])
+	}()
+}
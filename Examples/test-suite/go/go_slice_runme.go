@@ -0,0 +1,30 @@
+package main
+
+import . "./go_slice"
+
+func main() {
+	if Sum([]float64{1, 2, 3.5}) != 6.5 {
+		panic("Sum")
+	}
+	if Sum(nil) != 0 {
+		panic("Sum(nil)")
+	}
+
+	values := make([]int32, 4)
+	Fill(values, 10)
+	for i, v := range values {
+		if v != int32(10+i) {
+			panic("Fill")
+		}
+	}
+
+	// A sub-slice passes a pointer into the middle of the array.
+	Fill(values[2:], 0)
+	if values[1] != 11 || values[2] != 0 || values[3] != 1 {
+		panic("Fill sub-slice")
+	}
+
+	if Count_zeros([]byte{0, 1, 0, 2}) != 2 {
+		panic("Count_zeros")
+	}
+}
@@ -0,0 +1,31 @@
+%module go_batch
+
+// Test the go:batch feature
+
+%feature("go:batch") add;
+%feature("go:batch") Counter::add;
+%feature("go:batch") Counter::scaled;
+%feature("go:batch") Counter::bump;
+%feature("go:batch") Counter::isBig;
+%feature("go:batch") Counter::link;
+
+%warnfilter(SWIGWARN_GO_BATCH) Counter::name;
+%feature("go:batch") Counter::name;
+
+%inline %{
+enum Step { SMALL = 1, LARGE = 10 };
+
+int add(int a, int b) { return a + b; }
+
+struct Counter {
+  long long total;
+  Counter() : total(0) {}
+  void add(int n) { total += n; }
+  double scaled(float factor, const double &offset) const { return total * factor + offset; }
+  static int bump(Step step) { return step; }
+  bool isBig(long long limit) const { return total > limit; }
+  // Parameter names which clash with the Self field and with each other
+  int link(int self, int x, int X) const { return self * 100 + x * 10 + X; }
+  const char *name() const { return "counter"; }
+};
+%}
@@ -0,0 +1,35 @@
+%module go_slice
+
+// Test the SLICE typemaps in typemaps.i
+
+%include <typemaps.i>
+
+%apply (const double *SLICE, size_t LENGTH) { (const double *values, size_t n) };
+%apply (int *SLICE, size_t LENGTH) { (int *values, size_t n) };
+%apply (unsigned char *SLICE, size_t LENGTH) { (unsigned char *bytes, size_t n) };
+
+%inline %{
+#include <stddef.h>
+
+double sum(const double *values, size_t n) {
+  double total = 0;
+  size_t i;
+  for (i = 0; i < n; ++i)
+    total += values[i];
+  return total;
+}
+
+void fill(int *values, size_t n, int start) {
+  size_t i;
+  for (i = 0; i < n; ++i)
+    values[i] = start + (int)i;
+}
+
+size_t count_zeros(unsigned char *bytes, size_t n) {
+  size_t i, count = 0;
+  for (i = 0; i < n; ++i)
+    if (bytes[i] == 0)
+      ++count;
+  return count;
+}
+%}
@@ -0,0 +1,46 @@
+// This is the java_lib_arrays_nocopy_critical runtime testcase. It checks that the
+// CRITICAL arrays of arrays_nocopy.i are released before the Java exception is
+// raised for a C++ exception thrown by the wrapped function.
+
+import java_lib_arrays_nocopy_critical.*;
+
+public class java_lib_arrays_nocopy_critical_runme {
+
+  static {
+    try {
+	System.loadLibrary("java_lib_arrays_nocopy_critical");
+    } catch (UnsatisfiedLinkError e) {
+      System.err.println("Native code library failed to load. See the chapter on Dynamic Linking Problems in the SWIG Java documentation for help.\n" + e);
+      System.exit(1);
+    }
+  }
+
+  public static void main(String argv[]) {
+
+    double[] x = {1, 2, 3};
+    double[] y = {10, 20, 30};
+    java_lib_arrays_nocopy_critical.axpy(2, x, y);
+    if (y[0] != 12 || y[1] != 24 || y[2] != 36 || x[2] != 3)
+      throw new RuntimeException("axpy failed");
+
+    // The throws typemap reports a different message if the arrays are still
+    // held when it raises the exception
+    for (int i = 0; i < 100; i++) {
+      String message = null;
+      try {
+        java_lib_arrays_nocopy_critical.axpy(2, x, new double[2]);
+      } catch (RuntimeException e) {
+        message = e.getMessage();
+      }
+      if (!"array lengths differ".equals(message))
+        throw new RuntimeException("wrong exception for a length mismatch: " + message);
+      System.gc();
+      double[] garbage = new double[100000];
+      garbage[0] = i;
+    }
+
+    java_lib_arrays_nocopy_critical.axpy(1, x, y);
+    if (y[0] != 13 || y[1] != 26 || y[2] != 39)
+      throw new RuntimeException("axpy after exceptions failed");
+  }
+}
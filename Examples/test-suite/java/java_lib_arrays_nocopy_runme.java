@@ -0,0 +1,71 @@
+// This is the java_lib_arrays_nocopy runtime testcase. It checks the CRITICAL, REGION
+// and DIRECT typemaps in arrays_nocopy.i pass the Java data through and back.
+
+import java_lib_arrays_nocopy.*;
+import java.nio.*;
+
+public class java_lib_arrays_nocopy_runme {
+
+  static {
+    try {
+	System.loadLibrary("java_lib_arrays_nocopy");
+    } catch (UnsatisfiedLinkError e) {
+      System.err.println("Native code library failed to load. See the chapter on Dynamic Linking Problems in the SWIG Java documentation for help.\n" + e);
+      System.exit(1);
+    }
+  }
+
+  public static void main(String argv[]) {
+
+    // CRITICAL
+    double[] doubles = {1.5, 2.5, 3.5};
+    java_lib_arrays_nocopy.scale_critical(doubles, 2.0);
+    if (doubles[0] != 3.0 || doubles[1] != 5.0 || doubles[2] != 7.0)
+      throw new RuntimeException("scale_critical failed");
+    java_lib_arrays_nocopy.scale_critical(new double[0], 2.0);
+
+    float[] floats = {1, 2, 3, 4};
+    if (java_lib_arrays_nocopy.sum_critical(floats) != 10)
+      throw new RuntimeException("sum_critical failed");
+
+    // REGION
+    int[] ints = {10, 20};
+    if (java_lib_arrays_nocopy.increment_region(ints) != 2 || ints[0] != 11 || ints[1] != 21)
+      throw new RuntimeException("increment_region failed");
+    if (java_lib_arrays_nocopy.increment_region(new int[0]) != 0)
+      throw new RuntimeException("increment_region empty array failed");
+
+    short[] shorts = {100, 200, 300};
+    if (java_lib_arrays_nocopy.sum_region(shorts) != 600)
+      throw new RuntimeException("sum_region failed");
+
+    // DIRECT
+    ByteBuffer bytes = ByteBuffer.allocateDirect(3);
+    if (java_lib_arrays_nocopy.fill_direct(bytes) != 3 || (bytes.get(2) & 0xff) != 202)
+      throw new RuntimeException("fill_direct failed");
+
+    LongBuffer longs = ByteBuffer.allocateDirect(8*2).order(ByteOrder.nativeOrder()).asLongBuffer();
+    java_lib_arrays_nocopy.fill_direct_longlong(longs);
+    if (longs.get(0) != 0 || longs.get(1) != 10000000000L)
+      throw new RuntimeException("fill_direct_longlong failed");
+
+    // Error handling
+    boolean thrown = false;
+    try {
+      java_lib_arrays_nocopy.fill_direct(ByteBuffer.allocate(3));
+    } catch (IllegalArgumentException e) {
+      thrown = true;
+    }
+    if (!thrown)
+      throw new RuntimeException("non-direct buffer not rejected");
+
+    thrown = false;
+    try {
+      java_lib_arrays_nocopy.scale_critical(null, 2.0);
+    } catch (NullPointerException e) {
+      thrown = true;
+    }
+    if (!thrown)
+      throw new RuntimeException("null array not rejected");
+  }
+}
@@ -32,5 +32,28 @@ public class li_std_vector_runme {
     if (v4.get(0).getNum() != 12) throw new RuntimeException("v4 test failed");
     if (v5.get(0).getNum() != 34) throw new RuntimeException("v5 test failed");
     if (v6.get(0).getNum() != 56) throw new RuntimeException("v6 test failed");
+
+    // Bulk transfer methods
+    DoubleVector dv = new DoubleVector(new double[] {1.5, 2.5, 3.5});
+    if (dv.size() != 3 || dv.get(2) != 3.5) throw new RuntimeException("array constructor test failed");
+    dv.addAll(new double[] {4.5, 5.5});
+    double[] da = dv.toArray();
+    if (da.length != 5 || da[0] != 1.5 || da[4] != 5.5) throw new RuntimeException("toArray test failed");
+    dv.setRange(1, new double[] {20, 30});
+    da = dv.getRange(1, 3);
+    if (da.length != 3 || da[0] != 20 || da[1] != 30 || da[2] != 4.5) throw new RuntimeException("getRange/setRange test failed");
+    try {
+      dv.getRange(4, 2);
+      throw new RuntimeException("getRange out of range test failed");
+    } catch (IndexOutOfBoundsException e) {
+    }
+    dv.fromArray(new double[0]);
+    if (!dv.isEmpty() || dv.toArray().length != 0) throw new RuntimeException("fromArray test failed");
+
+    java.util.List<Short> sl = new ShortVector(new short[] {1, 2}).asList();
+    sl.addAll(java.util.Arrays.asList(new Short[] {3, 4}));
+    sl.set(0, (short)10);
+    if (sl.size() != 4 || sl.get(0) != 10 || sl.get(3) != 4 || !(sl instanceof java.util.RandomAccess))
+      throw new RuntimeException("asList test failed");
   }
 }
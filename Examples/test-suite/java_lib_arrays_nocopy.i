@@ -0,0 +1,57 @@
+/* Testcase for the pointer and length typemaps in arrays_nocopy.i */
+%module java_lib_arrays_nocopy
+
+%include <arrays_nocopy.i>
+
+%apply (double *CRITICAL, size_t LENGTH) { (double *critical, size_t n) }
+%apply (const float *CRITICAL, int LENGTH) { (const float *critical, int n) }
+%apply (int *REGION, size_t LENGTH) { (int *region, size_t n) }
+%apply (const short *REGION, int LENGTH) { (const short *region, int n) }
+%apply (unsigned char *DIRECT, size_t LENGTH) { (unsigned char *direct, size_t n) }
+%apply (long long *DIRECT, int LENGTH) { (long long *direct, int n) }
+
+%inline %{
+#include <stddef.h>
+
+void scale_critical(double *critical, size_t n, double factor) {
+  size_t i;
+  for (i = 0; i < n; i++)
+    critical[i] *= factor;
+}
+
+float sum_critical(const float *critical, int n) {
+  float total = 0;
+  int i;
+  for (i = 0; i < n; i++)
+    total += critical[i];
+  return total;
+}
+
+size_t increment_region(int *region, size_t n) {
+  size_t i;
+  for (i = 0; i < n; i++)
+    region[i]++;
+  return n;
+}
+
+int sum_region(const short *region, int n) {
+  int total = 0;
+  int i;
+  for (i = 0; i < n; i++)
+    total += region[i];
+  return total;
+}
+
+size_t fill_direct(unsigned char *direct, size_t n) {
+  size_t i;
+  for (i = 0; i < n; i++)
+    direct[i] = (unsigned char)(200 + i);
+  return n;
+}
+
+void fill_direct_longlong(long long *direct, int n) {
+  int i;
+  for (i = 0; i < n; i++)
+    direct[i] = 10000000000LL * i;
+}
+%}
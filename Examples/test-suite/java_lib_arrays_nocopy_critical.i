@@ -0,0 +1,29 @@
+/* Testcase for releasing the CRITICAL arrays of arrays_nocopy.i on every return path */
+%module java_lib_arrays_nocopy_critical
+
+%include <arrays_nocopy.i>
+
+%apply (const double *CRITICAL, int LENGTH) { (const double *x, int nx) }
+%apply (double *CRITICAL, int LENGTH) { (double *y, int ny) }
+
+/* The arrays must have been released before the handler raises the Java exception */
+%typemap(throws) const char * %{
+  if (_global_critical_arrays.held()) {
+    SWIG_JavaThrowException(jenv, SWIG_JavaRuntimeException, "critical arrays held in the catch handler");
+    return $null;
+  }
+  SWIG_JavaThrowException(jenv, SWIG_JavaRuntimeException, $1);
+  return $null;
+%}
+
+%catches(const char *) axpy;
+
+%inline %{
+/* y += a*x, both arrays must have the same length */
+void axpy(double a, const double *x, int nx, double *y, int ny) {
+  if (nx != ny)
+    throw "array lengths differ";
+  for (int i = 0; i < nx; i++)
+    y[i] += a * x[i];
+}
+%}
@@ -0,0 +1,5 @@
+%module overload_template_tree
+
+%treedispatch;
+
+%include overload_template.i
@@ -0,0 +1,29 @@
+from python_builtin_slots import *
+
+m = Matrix()
+if m[2] != 2 or m["x"] != -1:
+  raise RuntimeError("Matrix.__getitem__")
+
+m[1] = 7
+if m[1] != 7:
+  raise RuntimeError("Matrix.__setitem__")
+
+if (m + 5)[0] != 5 or (m + Matrix(3))[0] != 3:
+  raise RuntimeError("Matrix.__add__")
+
+try:
+  m + "x"
+  raise RuntimeError("Matrix.__add__ accepted a string")
+except TypeError:
+  pass
+
+if m.__pow__(3) != 300 or m.__pow__(3, 1) != 301:
+  raise RuntimeError("Matrix.__pow__")
+
+r = Row()
+if r[2] != 12:
+  raise RuntimeError("Row.__getitem__")
+
+r[1] = 5
+if r[1] != 5:
+  raise RuntimeError("Row.__setitem__")
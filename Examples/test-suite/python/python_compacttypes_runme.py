@@ -0,0 +1,22 @@
+from python_compacttypes import *
+
+d = Derived()
+
+if get_b1(d) != 1:
+    raise RuntimeError
+
+if get_b2(d) != 2:
+    raise RuntimeError
+
+if get_d(d) != 3:
+    raise RuntimeError
+
+if get_d(from_void(as_void(d))) != 3:
+    raise RuntimeError
+
+b = Base1()
+try:
+    get_d(b)
+    raise RuntimeError("Base1 accepted as Derived")
+except TypeError:
+    pass
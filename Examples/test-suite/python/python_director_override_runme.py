@@ -0,0 +1,77 @@
+from python_director_override import *
+import weakref
+
+class OnlySecond(Hooks):
+  def second(self, i):
+    return -i
+
+h = OnlySecond()
+for i in range(3):
+  if h.call_first() != 1:
+    raise RuntimeError("first")
+  if h.call_second(5) != -5:
+    raise RuntimeError("second")
+  if h.call_third() != 3:
+    raise RuntimeError("third")
+
+# Overrides added to, and removed from, the python class after the first calls
+try:
+  OnlySecond.first = lambda self: 10
+  patched = True
+except AttributeError:
+  # classes derived from -builtin types can't be modified
+  patched = False
+
+if patched:
+  if h.call_first() != 10:
+    raise RuntimeError("first not overridden")
+
+  del OnlySecond.first
+  if h.call_first() != 1:
+    raise RuntimeError("first still overridden")
+
+  # an overriding method replaced after the first calls
+  second = OnlySecond.second
+  OnlySecond.second = lambda self, i: 10 * i
+  if h.call_second(5) != 50:
+    raise RuntimeError("second not replaced")
+  OnlySecond.second = second
+  if h.call_second(5) != -5:
+    raise RuntimeError("second not restored")
+
+# Methods supplied through __getattr__ or __getattribute__ count as overridden
+class GetAttr(Hooks):
+  def __getattr__(self, name):
+    if name == "first":
+      return lambda: 30
+    raise AttributeError(name)
+
+class GetAttribute(Hooks):
+  def __getattribute__(self, name):
+    if name == "first":
+      return lambda: 40
+    return Hooks.__getattribute__(self, name)
+
+g = GetAttribute()
+a = GetAttr()
+for i in range(3):
+  if g.call_first() != 40 or g.call_second(3) != 3:
+    raise RuntimeError("GetAttribute")
+  if a.call_first() != 1 or a.call_second(3) != 3:
+    raise RuntimeError("GetAttr")
+
+# A class further down the hierarchy
+class Derived(OnlySecond):
+  def first(self):
+    return 20
+
+d = Derived()
+if d.call_first() != 20 or d.call_second(2) != -2 or h.call_first() != 1:
+  raise RuntimeError("Derived")
+
+# The methods cached by the director don't keep the python object alive
+ref = weakref.ref(d)
+del d
+if ref() is not None:
+  raise RuntimeError("Derived instance leaked")
+
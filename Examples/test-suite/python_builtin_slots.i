@@ -0,0 +1,32 @@
+/* Test the operator and sequence slot closures generated with the -builtin option */
+
+%module python_builtin_slots
+
+%feature("python:slot", "mp_subscript", functype="binaryfunc") Matrix::__getitem__;
+%feature("python:slot", "mp_ass_subscript", functype="objobjargproc") Matrix::__setitem__;
+%feature("python:slot", "nb_power", functype="ternaryfunc") Matrix::__pow__;
+%feature("python:slot", "sq_item", functype="ssizeargfunc") Row::__getitem__;
+%feature("python:slot", "sq_ass_item", functype="ssizeobjargproc") Row::__setitem__;
+
+%inline %{
+class Matrix {
+  int d[4];
+public:
+  Matrix(int first = 0) { for (int i = 0; i < 4; ++i) d[i] = first + i; }
+  int __getitem__(int i) const { return d[i]; }
+  int __getitem__(const char *) const { return -1; }
+  void __setitem__(int i, int v) { d[i] = v; }
+  void __setitem__(int i) { d[i] = 0; }
+  Matrix operator+(int i) const { return Matrix(d[0] + i); }
+  Matrix operator+(const Matrix &m) const { return Matrix(d[0] + m.d[0]); }
+  int __pow__(int e, PyObject *modulo = 0) const { return e * 100 + (modulo && modulo != Py_None ? 1 : 0); }
+};
+
+class Row {
+  int d[4];
+public:
+  Row() { for (int i = 0; i < 4; ++i) d[i] = 10 + i; }
+  int __getitem__(int i, int offset = 0) const { return d[i] + offset; }
+  void __setitem__(int i, int v) { d[i] = v; }
+};
+%}
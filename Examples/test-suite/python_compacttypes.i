@@ -0,0 +1,27 @@
+%module python_compacttypes
+
+// Type table generated with -compacttypes, see python/Makefile.in
+
+%inline %{
+struct Base1 {
+  virtual ~Base1() {}
+  int b1;
+  Base1() : b1(1) {}
+};
+struct Base2 {
+  virtual ~Base2() {}
+  int b2;
+  Base2() : b2(2) {}
+};
+struct Derived : Base1, Base2 {
+  int d;
+  Derived() : d(3) {}
+};
+typedef Derived DerivedTypedef;
+
+int get_b1(Base1 *b) { return b->b1; }
+int get_b2(Base2 *b) { return b->b2; }
+int get_d(DerivedTypedef *d) { return d->d; }
+void *as_void(void *v) { return v; }
+Derived *from_void(void *v) { return (Derived *)v; }
+%}
@@ -0,0 +1,18 @@
+/* Test that director methods not overridden in python call the C++ implementation */
+
+%module(directors="1") python_director_override
+
+%feature("director") Hooks;
+
+%inline %{
+class Hooks {
+public:
+  virtual ~Hooks() {}
+  virtual int first() { return 1; }
+  virtual int second(int i) { return i; }
+  virtual void third(int &i) { i = 3; }
+  int call_first() { return first(); }
+  int call_second(int i) { return second(i); }
+  int call_third() { int i = 0; third(i); return i; }
+};
+%}
@@ -0,0 +1,55 @@
+%module r_vector_view
+
+%include <std_vector.i>
+
+%apply std::vector<double> VIEW { std::vector<double> double_view };
+%apply std::vector<float> VIEW { std::vector<float> float_view };
+%apply const std::vector<int>& VIEW { const std::vector<int>& int_view };
+
+%inline %{
+#include <vector>
+
+std::vector<double> double_copy(int n) {
+  std::vector<double> v;
+  for (int i = 0; i < n; i++)
+    v.push_back(i * 0.5);
+  return v;
+}
+
+std::vector<double> double_view(int n) {
+  return double_copy(n);
+}
+
+std::vector<float> float_view(int n) {
+  std::vector<float> v;
+  for (int i = 0; i < n; i++)
+    v.push_back(i * 0.5f);
+  return v;
+}
+
+const std::vector<int>& int_view() {
+  static std::vector<int> v;
+  if (v.empty())
+    for (int i = 0; i < 5; i++)
+      v.push_back(i * i);
+  return v;
+}
+
+const std::vector<int>& int_ref() {
+  return int_view();
+}
+
+double vector_sum(const std::vector<double>& v) {
+  double sum = 0;
+  for (size_t i = 0; i < v.size(); i++)
+    sum += v[i];
+  return sum;
+}
+
+unsigned int unsigned_sum(std::vector<unsigned int> v) {
+  unsigned int sum = 0;
+  for (size_t i = 0; i < v.size(); i++)
+    sum += v[i];
+  return sum;
+}
+%}
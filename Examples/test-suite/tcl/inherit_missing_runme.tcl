@@ -0,0 +1,25 @@
+
+if [ catch { load ./inherit_missing[info sharedlibextension] inherit_missing} err_msg ] {
+	puts stderr "Could not load shared object:\n$err_msg"
+}
+
+set a [new_Foo]
+Bar b
+Spam c
+
+if {[do_blah $a] != "Foo::blah"} {
+    puts stderr "inherit_missing test 1 failed"
+    exit 1
+}
+
+if {[do_blah b] != "Bar::blah"} {
+    puts stderr "inherit_missing test 2 failed"
+    exit 1
+}
+
+if {[do_blah c] != "Spam::blah"} {
+    puts stderr "inherit_missing test 3 failed"
+    exit 1
+}
+
+delete_Foo $a
@@ -0,0 +1,50 @@
+
+if [ catch { load ./tcl_swigpointer[info sharedlibextension] tcl_swigpointer} err_msg ] {
+	puts stderr "Could not load shared object:\n$err_msg"
+}
+
+set a [make_Base]
+Derived d
+
+# Same pointer passed repeatedly, by object name and by pointer value
+foreach i {1 2 3} {
+    if {[base_name $a] != "Base"} {
+        puts stderr "tcl_swigpointer test 1 failed"
+        exit 1
+    }
+    if {[base_name d] != "Derived"} {
+        puts stderr "tcl_swigpointer test 2 failed"
+        exit 1
+    }
+    if {[base_name [d cget -this]] != "Derived"} {
+        puts stderr "tcl_swigpointer test 3 failed"
+        exit 1
+    }
+}
+
+# A pointer rebuilt from its string form must still convert
+set s [string range [d cget -this] 0 end]
+if {[base_name $s] != "Derived"} {
+    puts stderr "tcl_swigpointer test 4 failed"
+    exit 1
+}
+
+# Pointer values keep their usual string representation
+if {![string match "_*_p_Derived" [d cget -this]]} {
+    puts stderr "tcl_swigpointer test 5 failed"
+    exit 1
+}
+
+# A returned instance pointer names its object command
+set b [same_base $a]
+if {$b != $a || [$b name] != "Base"} {
+    puts stderr "tcl_swigpointer test 6 failed"
+    exit 1
+}
+
+if {![catch {base_name "_1234_p_Unknown"}]} {
+    puts stderr "tcl_swigpointer test 7 failed"
+    exit 1
+}
+
+free_Base $a
@@ -0,0 +1,34 @@
+// Tests the swigpointer Tcl_ObjType used to hold pointer values
+%module tcl_swigpointer
+
+%newobject make_Base;
+%delobject free_Base;
+
+%inline %{
+class Base {
+public:
+  virtual ~Base() {}
+  virtual const char *name() { return "Base"; }
+};
+
+class Derived : public Base {
+public:
+  virtual const char *name() { return "Derived"; }
+};
+
+Base *make_Base() {
+  return new Base();
+}
+
+void free_Base(Base *b) {
+  delete b;
+}
+
+const char *base_name(Base *b) {
+  return b->name();
+}
+
+Base *same_base(Base *b) {
+  return b;
+}
+%}
@@ -16,6 +16,9 @@
  *   SWIG_STD_VECTOR_ENHANCED(SomeNamespace::Klass)
  *   %template(VectKlass) std::vector<SomeNamespace::Klass>;
  *
+ * For the blittable primitive types, CopyTo, ToArray and the constructor taking an array
+ * copy all the elements in one call to C++ while the C# array is pinned.
+ *
  * Warning: heavy macro usage in this file. Use swig -E to get a sane view on the real file contents!
  * ----------------------------------------------------------------------------- */
 
@@ -26,11 +29,24 @@
 
 // MACRO for use within the std::vector class body
 %define SWIG_STD_VECTOR_MINIMUM_INTERNAL(CSINTERFACE, CONST_REFERENCE, CTYPE...)
+SWIG_STD_VECTOR_COLLECTION_INTERNAL(CSINTERFACE, Elementwise, %arg(CONST_REFERENCE), %arg(CTYPE))
+%enddef
+
+// BULK selects the private copyTo##BULK and addRange##BULK methods used to copy to and from
+// C# arrays, Elementwise copies one element per call, Pinned (blittable types) copies in one call
+%define SWIG_STD_VECTOR_COLLECTION_INTERNAL(CSINTERFACE, BULK, CONST_REFERENCE, CTYPE...)
 %typemap(csinterfaces) std::vector< CTYPE > "IDisposable, System.Collections.IEnumerable\n#if !SWIG_DOTNET_1\n    , System.Collections.Generic.CSINTERFACE<$typemap(cstype, CTYPE)>\n#endif\n";
 %typemap(cscode) std::vector< CTYPE > %{
   public $csclassname(System.Collections.ICollection c) : this() {
     if (c == null)
       throw new ArgumentNullException("c");
+#if !SWIG_DOTNET_1
+    $typemap(cstype, CTYPE)[] array = c as $typemap(cstype, CTYPE)[];
+    if (array != null) {
+      addRange##BULK(array, array.Length);
+      return;
+    }
+#endif
     foreach ($typemap(cstype, CTYPE) element in c) {
       this.Add(element);
     }
@@ -116,10 +132,32 @@
       throw new ArgumentException("Multi dimensional array.", "array");
     if (index+count > this.Count || arrayIndex+count > array.Length)
       throw new ArgumentException("Number of elements to copy is too large.");
+#if SWIG_DOTNET_1
     for (int i=0; i<count; i++)
       array.SetValue(getitemcopy(index+i), arrayIndex+i);
+#else
+    copyTo##BULK(index, array, arrayIndex, count);
+#endif
   }
 
+#if !SWIG_DOTNET_1
+  public $typemap(cstype, CTYPE)[] ToArray() {
+    $typemap(cstype, CTYPE)[] array = new $typemap(cstype, CTYPE)[this.Count];
+    copyTo##BULK(0, array, 0, array.Length);
+    return array;
+  }
+
+  private void copyToElementwise(int index, $typemap(cstype, CTYPE)[] array, int arrayIndex, int count) {
+    for (int i=0; i<count; i++)
+      array[arrayIndex+i] = getitemcopy(index+i);
+  }
+
+  private void addRangeElementwise($typemap(cstype, CTYPE)[] values, int count) {
+    for (int i=0; i<count; i++)
+      this.Add(values[i]);
+  }
+#endif
+
 #if !SWIG_DOTNET_1
   System.Collections.Generic.IEnumerator<$typemap(cstype, CTYPE)> System.Collections.Generic.IEnumerable<$typemap(cstype, CTYPE)>.GetEnumerator() {
     return new $csclassnameEnumerator(this);
@@ -351,6 +389,29 @@
     }
 %enddef
 
+// Extra methods added to the collection class for blittable types, the elements are copied
+// to and from C# arrays in one call while the array is pinned
+%define SWIG_STD_VECTOR_EXTRA_PINNED(CTYPE...)
+%typemap(ctype)  CTYPE *PINNED_ARRAY "CTYPE *"
+%typemap(imtype) CTYPE *PINNED_ARRAY "IntPtr"
+%typemap(cstype) CTYPE *PINNED_ARRAY "$typemap(cstype, CTYPE)[]"
+%typemap(csin,
+         pre="    GCHandle $csinput_handle = GCHandle.Alloc($csinput, GCHandleType.Pinned);",
+         post="      $csinput_handle.Free();"
+        ) CTYPE *PINNED_ARRAY "$csinput_handle.AddrOfPinnedObject()"
+%typemap(in) CTYPE *PINNED_ARRAY %{ $1 = ($1_ltype)$input; %}
+    %extend {
+      void copyToPinned(int index, CTYPE *PINNED_ARRAY, int arrayIndex, int count) throw (std::out_of_range) {
+        if (index < 0 || count < 0 || index > (int)$self->size() - count)
+          throw std::out_of_range("index");
+        std::copy($self->begin()+index, $self->begin()+index+count, PINNED_ARRAY+arrayIndex);
+      }
+      void addRangePinned(CTYPE *PINNED_ARRAY, int count) {
+        $self->insert($self->end(), PINNED_ARRAY, PINNED_ARRAY+count);
+      }
+    }
+%enddef
+
 // Macros for std::vector class specializations/enhancements
 %define SWIG_STD_VECTOR_ENHANCED(CTYPE...)
 namespace std {
@@ -361,6 +422,17 @@ namespace std {
 }
 %enddef
 
+// For blittable primitive types, whose C# arrays have the same layout as the C++ array
+%define SWIG_STD_VECTOR_BLITTABLE(CTYPE...)
+namespace std {
+  template<> class vector< CTYPE > {
+    SWIG_STD_VECTOR_COLLECTION_INTERNAL(IList, Pinned, %arg(CTYPE const&), %arg(CTYPE))
+    SWIG_STD_VECTOR_EXTRA_OP_EQUALS_EQUALS(CTYPE)
+    SWIG_STD_VECTOR_EXTRA_PINNED(CTYPE)
+  };
+}
+%enddef
+
 // Legacy macros
 %define SWIG_STD_VECTOR_SPECIALIZE(CSTYPE, CTYPE...)
 #warning SWIG_STD_VECTOR_SPECIALIZE macro deprecated, please see csharp/std_vector.i and switch to SWIG_STD_VECTOR_ENHANCED
@@ -383,6 +455,8 @@ SWIG_STD_VECTOR_ENHANCED(CTYPE)
 %csmethodmodifiers std::vector::size "private"
 %csmethodmodifiers std::vector::capacity "private"
 %csmethodmodifiers std::vector::reserve "private"
+%csmethodmodifiers std::vector::copyToPinned "private"
+%csmethodmodifiers std::vector::addRangePinned "private"
 
 namespace std {
   // primary (unspecialized) class template for std::vector
@@ -405,17 +479,17 @@ namespace std {
 // template specializations for std::vector
 // these provide extra collections methods as operator== is defined
 SWIG_STD_VECTOR_ENHANCED(char)
-SWIG_STD_VECTOR_ENHANCED(signed char)
-SWIG_STD_VECTOR_ENHANCED(unsigned char)
-SWIG_STD_VECTOR_ENHANCED(short)
-SWIG_STD_VECTOR_ENHANCED(unsigned short)
-SWIG_STD_VECTOR_ENHANCED(int)
-SWIG_STD_VECTOR_ENHANCED(unsigned int)
-SWIG_STD_VECTOR_ENHANCED(long)
+SWIG_STD_VECTOR_BLITTABLE(signed char)
+SWIG_STD_VECTOR_BLITTABLE(unsigned char)
+SWIG_STD_VECTOR_BLITTABLE(short)
+SWIG_STD_VECTOR_BLITTABLE(unsigned short)
+SWIG_STD_VECTOR_BLITTABLE(int)
+SWIG_STD_VECTOR_BLITTABLE(unsigned int)
+SWIG_STD_VECTOR_ENHANCED(long)               // C# int, so not blittable where C++ long is 64 bits
 SWIG_STD_VECTOR_ENHANCED(unsigned long)
-SWIG_STD_VECTOR_ENHANCED(long long)
-SWIG_STD_VECTOR_ENHANCED(unsigned long long)
-SWIG_STD_VECTOR_ENHANCED(float)
-SWIG_STD_VECTOR_ENHANCED(double)
+SWIG_STD_VECTOR_BLITTABLE(long long)
+SWIG_STD_VECTOR_BLITTABLE(unsigned long long)
+SWIG_STD_VECTOR_BLITTABLE(float)
+SWIG_STD_VECTOR_BLITTABLE(double)
 SWIG_STD_VECTOR_ENHANCED(std::string) // also requires a %include <std_string.i>
 
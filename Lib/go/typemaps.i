@@ -290,3 +290,75 @@ INOUT_TYPEMAP(float, float32);
 INOUT_TYPEMAP(double, float64);
 
 #undef INOUT_TYPEMAP
+
+/*
+SLICE typemaps
+--------------
+
+Mappings for a pointer and length pair which is passed as a single Go
+slice.  The C/C++ function is passed a pointer to the slice's backing
+array, which is not copied, and the slice length.
+
+        (bool               *SLICE, size_t LENGTH)
+        (signed char        *SLICE, size_t LENGTH)
+        (char               *SLICE, size_t LENGTH)
+        (unsigned char      *SLICE, size_t LENGTH)
+        (short              *SLICE, size_t LENGTH)
+        (unsigned short     *SLICE, size_t LENGTH)
+        (int                *SLICE, size_t LENGTH)
+        (unsigned int       *SLICE, size_t LENGTH)
+        (long long          *SLICE, size_t LENGTH)
+        (unsigned long long *SLICE, size_t LENGTH)
+        (float              *SLICE, size_t LENGTH)
+        (double             *SLICE, size_t LENGTH)
+
+and the same with a const pointer.  For example:
+
+        %include <typemaps.i>
+        %apply (const double *SLICE, size_t LENGTH) { (const double *values, size_t n) };
+        %apply (double *SLICE, size_t LENGTH) { (double *values, size_t n) };
+        double sum(const double *values, size_t n);
+        void scale(double *values, size_t n, double factor);
+
+In Go you would use it like this:
+
+        x := []float64{1.0, 2.0, 3.0}
+        Scale(x, 2.0)
+        total := Sum(x)
+
+Changes made to the array by the C/C++ function are seen by Go.  The
+Go types used are those with the same size as the C/C++ type, so long
+is not supported as its size depends on the platform.  The backing
+array is kept alive by the Go caller for the duration of the call, but
+the C/C++ function must not keep the pointer after it returns.
+*/
+
+%define SLICE_TYPEMAP(TYPE, GOTYPE)
+%typemap(gotype) (TYPE *SLICE, size_t LENGTH), (const TYPE *SLICE, size_t LENGTH) %{[]GOTYPE%}
+
+%typemap(in) (TYPE *SLICE, size_t LENGTH), (const TYPE *SLICE, size_t LENGTH)
+%{
+  $1 = ($1_ltype)$input.array;
+  $2 = ($2_ltype)$input.len;
+%}
+
+%typemap(freearg) (TYPE *SLICE, size_t LENGTH), (const TYPE *SLICE, size_t LENGTH) ""
+
+%typemap(argout) (TYPE *SLICE, size_t LENGTH), (const TYPE *SLICE, size_t LENGTH) ""
+
+%enddef
+
+SLICE_TYPEMAP(bool, bool);
+SLICE_TYPEMAP(signed char, int8);
+SLICE_TYPEMAP(char, byte);
+SLICE_TYPEMAP(unsigned char, byte);
+SLICE_TYPEMAP(short, int16);
+SLICE_TYPEMAP(unsigned short, uint16);
+SLICE_TYPEMAP(int, int32);
+SLICE_TYPEMAP(unsigned int, uint32);
+SLICE_TYPEMAP(long long, int64);
+SLICE_TYPEMAP(unsigned long long, uint64);
+SLICE_TYPEMAP(float, float32);
+SLICE_TYPEMAP(double, float64);
+
+#undef SLICE_TYPEMAP
@@ -0,0 +1,240 @@
+/* -----------------------------------------------------------------------------
+ * arrays_nocopy.i
+ *
+ * Typemaps for passing large arrays of primitive types to C/C++ without the
+ * element by element copying done by arrays_java.i and typemaps.i. They are used
+ * for a pointer and length pair and are applied to the parameters that need
+ * them:
+ *
+ *   %include <arrays_nocopy.i>
+ *   %apply (double *CRITICAL, size_t LENGTH) { (double *data, size_t n) }
+ *   %apply (const float *REGION, int LENGTH) { (const float *in, int len) }
+ *   %apply (double *DIRECT, size_t LENGTH) { (double *buf, size_t count) }
+ *
+ * Use from Java like this:
+ *
+ *   double[] data = new double[1000000];
+ *   example.scale(data, 2.0);
+ *   DoubleBuffer buf = ByteBuffer.allocateDirect(8*1000000).order(ByteOrder.nativeOrder()).asDoubleBuffer();
+ *   example.fill(buf);
+ *
+ * The element types supported are signed char and unsigned char (byte[]), short
+ * (short[]), int (int[]), long long (long[]), float (float[]) and double
+ * (double[]), with a LENGTH of type size_t or int.
+ *
+ * CRITICAL   The Java array is used in place via GetPrimitiveArrayCritical, so
+ *            changes made by C/C++ are seen in Java. The const variant releases
+ *            the array with JNI_ABORT so nothing is written back. The JVM may
+ *            stall garbage collection while the array is held, so only use it
+ *            for short, non-blocking functions which do not call back into Java.
+ *            The other parameters and the return type should be primitive
+ *            types and any %exception code must not make JNI calls before
+ *            $action. The arrays are held from their check typemap until the
+ *            function returns or throws. In C++ they are released before the
+ *            handlers of an exception specification or %catches raise the
+ *            Java exception.
+ * REGION     The array is copied into a temporary C array with one
+ *            Get<Type>ArrayRegion call and, for the non-const variant, copied
+ *            back with one Set<Type>ArrayRegion call. No restrictions apply.
+ * DIRECT     A direct java.nio buffer (ByteBuffer for the char types,
+ *            ShortBuffer, IntBuffer, LongBuffer, FloatBuffer, DoubleBuffer) is
+ *            used in place via GetDirectBufferAddress. LENGTH is the buffer
+ *            capacity in elements. Views of a ByteBuffer must use the native
+ *            byte order. The memory remains valid for as long as Java holds a
+ *            reference to the buffer.
+ * ----------------------------------------------------------------------------- */
+
+%fragment("SWIG_JavaCriticalArrays", "header") {
+/* The arrays held with GetPrimitiveArrayCritical by a wrapper, most recently
+   acquired first, so that all of them can be released on any return path */
+typedef struct SWIG_JavaCriticalArray {
+  jarray array;
+  void *elems;
+  jint mode;
+  struct SWIG_JavaCriticalArray *next;
+} SWIG_JavaCriticalArray;
+
+SWIGINTERN void *SWIG_JavaAcquireCriticalArray(JNIEnv *jenv, SWIG_JavaCriticalArray **arrays, SWIG_JavaCriticalArray *a, jarray array, jint mode) {
+  a->array = array;
+  a->mode = mode;
+  a->elems = JCALL2(GetPrimitiveArrayCritical, jenv, array, 0);
+  if (a->elems) {
+    a->next = *arrays;
+    *arrays = a;
+  }
+  return a->elems;
+}
+
+SWIGINTERN void SWIG_JavaReleaseCriticalArrays(JNIEnv *jenv, SWIG_JavaCriticalArray **arrays) {
+  while (*arrays) {
+    SWIG_JavaCriticalArray *a = *arrays;
+    *arrays = a->next;
+    JCALL3(ReleasePrimitiveArrayCritical, jenv, a->array, a->elems, a->mode);
+  }
+}
+
+#ifdef __cplusplus
+namespace Swig {
+  /* Releases the arrays still held when the wrapper returns */
+  class JavaCriticalArrays {
+    JNIEnv *jenv_;
+    SWIG_JavaCriticalArray *arrays_;
+  public:
+    JavaCriticalArrays(JNIEnv *jenv) : jenv_(jenv), arrays_(0) {
+    }
+    ~JavaCriticalArrays() {
+      release();
+    }
+    void *acquire(SWIG_JavaCriticalArray *a, jarray array, jint mode) {
+      return SWIG_JavaAcquireCriticalArray(jenv_, &arrays_, a, array, mode);
+    }
+    void release() {
+      SWIG_JavaReleaseCriticalArrays(jenv_, &arrays_);
+    }
+    bool held() const {
+      return arrays_ != 0;
+    }
+  };
+
+  /* Declared just before the wrapped call, inside the try block of any
+     exception handlers, so that the arrays are released before a handler
+     raises a Java exception */
+  class JavaCriticalArraysScope {
+    JavaCriticalArrays &arrays_;
+  public:
+    JavaCriticalArraysScope(JavaCriticalArrays &arrays) : arrays_(arrays) {
+    }
+    ~JavaCriticalArraysScope() {
+      arrays_.release();
+    }
+  };
+}
+#endif
+}
+
+%define JAVA_ARRAYS_NOCOPY(CTYPE, JTYPE, JNITYPE, JFUNCNAME, JBUFFER, TYPECHECKPRECEDENCE)
+
+/* CRITICAL: the array is acquired in the check typemap, after all the other
+ * parameters have been marshalled, and released as soon as the function returns.
+ * The arrays of all the CRITICAL parameters are chained in a wrapper wide local,
+ * so that a failing acquire releases the ones before it. In C++ that local also
+ * releases them on the other early returns, and the check typemap's preaction
+ * releases them when the function throws, before any catch handler runs. */
+%typemap(jni)    (CTYPE *CRITICAL, size_t LENGTH), (const CTYPE *CRITICAL, size_t LENGTH) %{JNITYPE##Array%}
+%typemap(jtype)  (CTYPE *CRITICAL, size_t LENGTH), (const CTYPE *CRITICAL, size_t LENGTH) %{JTYPE[]%}
+%typemap(jstype) (CTYPE *CRITICAL, size_t LENGTH), (const CTYPE *CRITICAL, size_t LENGTH) %{JTYPE[]%}
+%typemap(javain) (CTYPE *CRITICAL, size_t LENGTH), (const CTYPE *CRITICAL, size_t LENGTH) "$javainput"
+%typemap(in)     (CTYPE *CRITICAL, size_t LENGTH), (const CTYPE *CRITICAL, size_t LENGTH) {
+  if (!$input) {
+    SWIG_JavaThrowException(jenv, SWIG_JavaNullPointerException, "null array");
+    return $null;
+  }
+  $1 = 0;
+  $2 = ($2_ltype) JCALL1(GetArrayLength, jenv, $input);
+}
+#ifdef __cplusplus
+%typemap(check, noblock=1, fragment="SWIG_JavaCriticalArrays",
+         preaction="Swig::JavaCriticalArraysScope _swig_critical_scope(_global_critical_arrays);") (CTYPE *CRITICAL, size_t LENGTH)
+  (SWIG_JavaCriticalArray critical, Swig::JavaCriticalArrays _global_critical_arrays = jenv) {
+  $1 = ($1_ltype) _global_critical_arrays.acquire(&critical, $input, 0);
+  if (!$1) return $null;
+}
+%typemap(check, noblock=1, fragment="SWIG_JavaCriticalArrays",
+         preaction="Swig::JavaCriticalArraysScope _swig_critical_scope(_global_critical_arrays);") (const CTYPE *CRITICAL, size_t LENGTH)
+  (SWIG_JavaCriticalArray critical, Swig::JavaCriticalArrays _global_critical_arrays = jenv) {
+  $1 = ($1_ltype) _global_critical_arrays.acquire(&critical, $input, JNI_ABORT);
+  if (!$1) return $null;
+}
+%typemap(argout) (CTYPE *CRITICAL, size_t LENGTH), (const CTYPE *CRITICAL, size_t LENGTH)
+%{ _global_critical_arrays.release(); %}
+#else
+%typemap(check, noblock=1, fragment="SWIG_JavaCriticalArrays") (CTYPE *CRITICAL, size_t LENGTH)
+  (SWIG_JavaCriticalArray critical, SWIG_JavaCriticalArray *_global_critical_arrays = 0) {
+  $1 = ($1_ltype) SWIG_JavaAcquireCriticalArray(jenv, &_global_critical_arrays, &critical, $input, 0);
+  if (!$1) {
+    SWIG_JavaReleaseCriticalArrays(jenv, &_global_critical_arrays);
+    return $null;
+  }
+}
+%typemap(check, noblock=1, fragment="SWIG_JavaCriticalArrays") (const CTYPE *CRITICAL, size_t LENGTH)
+  (SWIG_JavaCriticalArray critical, SWIG_JavaCriticalArray *_global_critical_arrays = 0) {
+  $1 = ($1_ltype) SWIG_JavaAcquireCriticalArray(jenv, &_global_critical_arrays, &critical, $input, JNI_ABORT);
+  if (!$1) {
+    SWIG_JavaReleaseCriticalArrays(jenv, &_global_critical_arrays);
+    return $null;
+  }
+}
+%typemap(argout) (CTYPE *CRITICAL, size_t LENGTH), (const CTYPE *CRITICAL, size_t LENGTH)
+%{ SWIG_JavaReleaseCriticalArrays(jenv, &_global_critical_arrays); %}
+#endif
+
+/* REGION: one bulk copy into a temporary array and, unless const, one back */
+%typemap(jni)    (CTYPE *REGION, size_t LENGTH), (const CTYPE *REGION, size_t LENGTH) %{JNITYPE##Array%}
+%typemap(jtype)  (CTYPE *REGION, size_t LENGTH), (const CTYPE *REGION, size_t LENGTH) %{JTYPE[]%}
+%typemap(jstype) (CTYPE *REGION, size_t LENGTH), (const CTYPE *REGION, size_t LENGTH) %{JTYPE[]%}
+%typemap(javain) (CTYPE *REGION, size_t LENGTH), (const CTYPE *REGION, size_t LENGTH) "$javainput"
+%typemap(in)     (CTYPE *REGION, size_t LENGTH), (const CTYPE *REGION, size_t LENGTH) {
+  jsize sz;
+  if (!$input) {
+    SWIG_JavaThrowException(jenv, SWIG_JavaNullPointerException, "null array");
+    return $null;
+  }
+  sz = JCALL1(GetArrayLength, jenv, $input);
+#ifdef __cplusplus
+  $1 = new CTYPE[sz ? sz : 1];
+#else
+  $1 = ($1_ltype) malloc((sz ? sz : 1) * sizeof(CTYPE));
+#endif
+  if (!$1) {
+    SWIG_JavaThrowException(jenv, SWIG_JavaOutOfMemoryError, "array memory allocation failed");
+    return $null;
+  }
+  JCALL4(Get##JFUNCNAME##ArrayRegion, jenv, $input, 0, sz, (JNITYPE *)$1);
+  $2 = ($2_ltype) sz;
+}
+%typemap(argout) (CTYPE *REGION, size_t LENGTH)
+%{ JCALL4(Set##JFUNCNAME##ArrayRegion, jenv, $input, 0, (jsize)$2, (JNITYPE *)$1); %}
+%typemap(freearg) (CTYPE *REGION, size_t LENGTH), (const CTYPE *REGION, size_t LENGTH)
+#ifdef __cplusplus
+%{ delete [] $1; %}
+#else
+%{ free((void *)$1); %}
+#endif
+
+/* DIRECT: the memory of a direct java.nio buffer */
+%typemap(jni)    (CTYPE *DIRECT, size_t LENGTH) "jobject"
+%typemap(jtype)  (CTYPE *DIRECT, size_t LENGTH) %{java.nio.JBUFFER%}
+%typemap(jstype) (CTYPE *DIRECT, size_t LENGTH) %{java.nio.JBUFFER%}
+%typemap(javain) (CTYPE *DIRECT, size_t LENGTH) "$javainput"
+%typemap(in)     (CTYPE *DIRECT, size_t LENGTH) {
+  if (!$input) {
+    SWIG_JavaThrowException(jenv, SWIG_JavaNullPointerException, "null buffer");
+    return $null;
+  }
+  $1 = ($1_ltype) JCALL1(GetDirectBufferAddress, jenv, $input);
+  if (!$1) {
+    SWIG_JavaThrowException(jenv, SWIG_JavaIllegalArgumentException, "direct buffer expected");
+    return $null;
+  }
+  $2 = ($2_ltype) JCALL1(GetDirectBufferCapacity, jenv, $input);
+}
+
+%typecheck(TYPECHECKPRECEDENCE) (CTYPE *CRITICAL, size_t LENGTH), (const CTYPE *CRITICAL, size_t LENGTH),
+                                (CTYPE *REGION, size_t LENGTH), (const CTYPE *REGION, size_t LENGTH) ""
+%typecheck(SWIG_TYPECHECK_POINTER) (CTYPE *DIRECT, size_t LENGTH) ""
+
+%apply (CTYPE *CRITICAL, size_t LENGTH) { (CTYPE *CRITICAL, int LENGTH) }
+%apply (const CTYPE *CRITICAL, size_t LENGTH) { (const CTYPE *CRITICAL, int LENGTH) }
+%apply (CTYPE *REGION, size_t LENGTH) { (CTYPE *REGION, int LENGTH) }
+%apply (const CTYPE *REGION, size_t LENGTH) { (const CTYPE *REGION, int LENGTH) }
+%apply (CTYPE *DIRECT, size_t LENGTH) { (CTYPE *DIRECT, int LENGTH) }
+%enddef
+
+JAVA_ARRAYS_NOCOPY(signed char, byte, jbyte, Byte, ByteBuffer, SWIG_TYPECHECK_INT8_ARRAY)      /* byte[] */
+JAVA_ARRAYS_NOCOPY(unsigned char, byte, jbyte, Byte, ByteBuffer, SWIG_TYPECHECK_INT8_ARRAY)    /* byte[], elements reinterpreted */
+JAVA_ARRAYS_NOCOPY(short, short, jshort, Short, ShortBuffer, SWIG_TYPECHECK_INT16_ARRAY)       /* short[] */
+JAVA_ARRAYS_NOCOPY(int, int, jint, Int, IntBuffer, SWIG_TYPECHECK_INT32_ARRAY)                 /* int[] */
+JAVA_ARRAYS_NOCOPY(long long, long, jlong, Long, LongBuffer, SWIG_TYPECHECK_INT64_ARRAY)       /* long[] */
+JAVA_ARRAYS_NOCOPY(float, float, jfloat, Float, FloatBuffer, SWIG_TYPECHECK_FLOAT_ARRAY)       /* float[] */
+JAVA_ARRAYS_NOCOPY(double, double, jdouble, Double, DoubleBuffer, SWIG_TYPECHECK_DOUBLE_ARRAY) /* double[] */
+
@@ -1,5 +1,19 @@
 /* -----------------------------------------------------------------------------
  * std_vector.i
+ *
+ * The specializations for the primitive types byte, short, int, long, float and
+ * double (signed char, short, int, long long, float and double in C++) also
+ * have bulk methods which copy the whole vector, or a range of it, to or from a
+ * Java array in one JNI call:
+ *
+ *   double[] toArray()
+ *   double[] getRange(int index, int count)
+ *   void setRange(int index, double[] values)
+ *   void addAll(double[] values)
+ *   void fromArray(double[] values)
+ *
+ * plus a constructor taking a Java array and asList(), which returns a
+ * java.util.List view of the vector implementing java.util.RandomAccess.
  * ----------------------------------------------------------------------------- */
 
 %include <std_common.i>
@@ -9,13 +23,12 @@
 #include <stdexcept>
 %}
 
-namespace std {
-    
-    template<class T> class vector {
+// MACRO for use within the std::vector class body
+%define SWIG_STD_VECTOR_MINIMUM_INTERNAL(CONST_REFERENCE, CTYPE...)
       public:
         typedef size_t size_type;
-        typedef T value_type;
-        typedef const value_type& const_reference;
+        typedef CTYPE value_type;
+        typedef CONST_REFERENCE const_reference;
         vector();
         vector(size_type n);
         size_type size() const;
@@ -42,44 +55,151 @@ namespace std {
                     throw std::out_of_range("vector index out of range");
             }
         }
-    };
+%enddef
 
-    // bool specialization
-    template<> class vector<bool> {
-      public:
-        typedef size_t size_type;
-        typedef bool value_type;
-        typedef bool const_reference;
-        vector();
-        vector(size_type n);
-        size_type size() const;
-        size_type capacity() const;
-        void reserve(size_type n);
-        %rename(isEmpty) empty;
-        bool empty() const;
-        void clear();
-        %rename(add) push_back;
-        void push_back(const value_type& x);
+// Bulk transfer methods for the std::vector class body, the elements are copied with
+// one Get/Set<Type>ArrayRegion call. The JNIEnv is passed in from the JNI wrapper.
+%define SWIG_STD_VECTOR_BULK_INTERNAL(CTYPE, JNITYPE, JNIARRAYTYPE, JFUNCNAME)
         %extend {
-            const_reference get(int i) throw (std::out_of_range) {
-                int size = int(self->size());
-                if (i>=0 && i<size)
-                    return (*self)[i];
-                else
-                    throw std::out_of_range("vector index out of range");
+            JNIARRAYTYPE toArray(JNIEnv *JNIENV) {
+                jsize sz = (jsize)self->size();
+                JNIARRAYTYPE array = JNIENV->New##JFUNCNAME##Array(sz);
+                if (array && sz)
+                    JNIENV->Set##JFUNCNAME##ArrayRegion(array, 0, sz, (const JNITYPE *)&(*self)[0]);
+                return array;
             }
-            void set(int i, const value_type& val) throw (std::out_of_range) {
-                int size = int(self->size());
-                if (i>=0 && i<size)
-                    (*self)[i] = val;
-                else
-                    throw std::out_of_range("vector index out of range");
+            JNIARRAYTYPE getRange(JNIEnv *JNIENV, int index, int count) throw (std::out_of_range) {
+                if (index < 0 || count < 0 || index > int(self->size()) - count)
+                    throw std::out_of_range("vector range out of range");
+                JNIARRAYTYPE array = JNIENV->New##JFUNCNAME##Array(count);
+                if (array && count)
+                    JNIENV->Set##JFUNCNAME##ArrayRegion(array, 0, count, (const JNITYPE *)&(*self)[index]);
+                return array;
+            }
+            void setRange(JNIEnv *JNIENV, int index, JNIARRAYTYPE values) throw (std::out_of_range) {
+                if (!values) {
+                    SWIG_JavaThrowException(JNIENV, SWIG_JavaNullPointerException, "null array");
+                    return;
+                }
+                jsize sz = JNIENV->GetArrayLength(values);
+                if (index < 0 || index > int(self->size()) - sz)
+                    throw std::out_of_range("vector range out of range");
+                if (sz)
+                    JNIENV->Get##JFUNCNAME##ArrayRegion(values, 0, sz, (JNITYPE *)&(*self)[index]);
+            }
+            void addAll(JNIEnv *JNIENV, JNIARRAYTYPE values) {
+                if (!values) {
+                    SWIG_JavaThrowException(JNIENV, SWIG_JavaNullPointerException, "null array");
+                    return;
+                }
+                jsize sz = JNIENV->GetArrayLength(values);
+                if (sz) {
+                    size_t index = self->size();
+                    self->resize(index + sz);
+                    JNIENV->Get##JFUNCNAME##ArrayRegion(values, 0, sz, (JNITYPE *)&(*self)[index]);
+                }
+            }
+            void fromArray(JNIEnv *JNIENV, JNIARRAYTYPE values) {
+                if (!values) {
+                    SWIG_JavaThrowException(JNIENV, SWIG_JavaNullPointerException, "null array");
+                    return;
+                }
+                jsize sz = JNIENV->GetArrayLength(values);
+                self->resize(sz);
+                if (sz)
+                    JNIENV->Get##JFUNCNAME##ArrayRegion(values, 0, sz, (JNITYPE *)&(*self)[0]);
             }
         }
+%enddef
+
+%typemap(in, numinputs=0) JNIEnv *JNIENV "$1 = jenv;"
+
+namespace std {
+
+    template<class T> class vector {
+        SWIG_STD_VECTOR_MINIMUM_INTERNAL(const T&, T)
+    };
+
+    // bool specialization
+    template<> class vector<bool> {
+        SWIG_STD_VECTOR_MINIMUM_INTERNAL(bool, bool)
     };
 }
 
+// Specialization for a primitive type with a Java array equivalent
+%define SWIG_STD_VECTOR_PRIMITIVE(CTYPE, JTYPE, JBOXTYPE, JNITYPE, JFUNCNAME)
+%typemap(javacode) std::vector< CTYPE > %{
+  public $javaclassname(JTYPE[] values) {
+    this();
+    addAll(values);
+  }
+
+  public java.util.List<JBOXTYPE> asList() {
+    return new ListView();
+  }
+
+  // List view of the vector, the bulk methods are used where the List interface allows
+  private class ListView extends java.util.AbstractList<JBOXTYPE> implements java.util.RandomAccess {
+    public int size() {
+      return (int)$javaclassname.this.size();
+    }
+
+    public JBOXTYPE get(int index) {
+      return $javaclassname.this.get(index);
+    }
+
+    public JBOXTYPE set(int index, JBOXTYPE value) {
+      JTYPE old = $javaclassname.this.get(index);
+      $javaclassname.this.set(index, value);
+      return old;
+    }
+
+    public void add(int index, JBOXTYPE value) {
+      if (index != size())
+        throw new UnsupportedOperationException("elements can only be added to the end");
+      $javaclassname.this.add(value);
+      modCount++;
+    }
+
+    public boolean addAll(java.util.Collection<? extends JBOXTYPE> c) {
+      JTYPE[] values = new JTYPE[c.size()];
+      int i = 0;
+      for (JBOXTYPE value : c)
+        values[i++] = value;
+      $javaclassname.this.addAll(values);
+      modCount++;
+      return values.length != 0;
+    }
+
+    public void clear() {
+      $javaclassname.this.clear();
+      modCount++;
+    }
+
+    public Object[] toArray() {
+      JTYPE[] values = $javaclassname.this.toArray();
+      Object[] result = new Object[values.length];
+      for (int i = 0; i < values.length; i++)
+        result[i] = values[i];
+      return result;
+    }
+  }
+%}
+namespace std {
+    template<> class vector< CTYPE > {
+        SWIG_STD_VECTOR_MINIMUM_INTERNAL(const CTYPE&, CTYPE)
+        SWIG_STD_VECTOR_BULK_INTERNAL(CTYPE, JNITYPE, JNITYPE##Array, JFUNCNAME)
+    };
+}
+%enddef
+
+SWIG_STD_VECTOR_PRIMITIVE(signed char, byte, Byte, jbyte, Byte)
+SWIG_STD_VECTOR_PRIMITIVE(short, short, Short, jshort, Short)
+SWIG_STD_VECTOR_PRIMITIVE(int, int, Integer, jint, Int)
+SWIG_STD_VECTOR_PRIMITIVE(long long, long, Long, jlong, Long)
+SWIG_STD_VECTOR_PRIMITIVE(float, float, Float, jfloat, Float)
+SWIG_STD_VECTOR_PRIMITIVE(double, double, Double, jdouble, Double)
+
 %define specialize_std_vector(T)
 #warning "specialize_std_vector - specialization for type T no longer needed"
 %enddef
-
@@ -3,66 +3,113 @@
   Vectors
 */
 
-%fragment("StdVectorTraits","header",fragment="StdSequenceTraits")
+%fragment("StdVectorTraits","header",fragment="StdTraits",fragment="StdSequenceTraits")
 %{
+#include <algorithm>
+#include <string.h>
+
   namespace swig {
-    // vectors of doubles
+    // Storage of numeric vector elements on the R side.  Elements whose
+    // type matches the R storage type (direct) are moved with a single
+    // memcpy, others are converted by std::copy.
+    template <typename T> struct r_vector_storage;
     template <>
-      struct traits_from_ptr<std::vector<double> > {
-      static SEXP from (std::vector<double > *val, int owner = 0) {
-        SEXP result;
-        PROTECT(result = Rf_allocVector(REALSXP, val->size()));
-        for (unsigned pos = 0; pos < val->size(); pos++)
-          {
-            NUMERIC_POINTER(result)[pos] = ((*val)[pos]);
-          }
-        UNPROTECT(1);
-        return(result);
-      }
+      struct r_vector_storage<double> {
+      typedef double type;
+      static const SEXPTYPE sexptype = REALSXP;
+      static type *data(SEXP x) { return NUMERIC_POINTER(x); }
+      static const char *view_name() { return "swig_vector_double"; }
+      enum { direct = 1 };
     };
-    // vectors of floats
     template <>
-      struct traits_from_ptr<std::vector<float> > {
-      static SEXP from (std::vector<float > *val, int owner = 0) {
-        SEXP result;
-        PROTECT(result = Rf_allocVector(REALSXP, val->size()));
-        for (unsigned pos = 0; pos < val->size(); pos++)
-          {
-            NUMERIC_POINTER(result)[pos] = ((*val)[pos]);
-          }
-        UNPROTECT(1);
-        return(result);
-      }
+      struct r_vector_storage<float> {
+      typedef double type;
+      static const SEXPTYPE sexptype = REALSXP;
+      static type *data(SEXP x) { return NUMERIC_POINTER(x); }
+      static const char *view_name() { return "swig_vector_float"; }
+      enum { direct = 0 };
     };
-    // vectors of unsigned int
     template <>
-      struct traits_from_ptr<std::vector<unsigned int> > {
-      static SEXP from (std::vector<unsigned int > *val, int owner = 0) {
-        SEXP result;
-        PROTECT(result = Rf_allocVector(INTSXP, val->size()));
-        for (unsigned pos = 0; pos < val->size(); pos++)
-          {
-            INTEGER_POINTER(result)[pos] = ((*val)[pos]);
-          }
-        UNPROTECT(1);
-        return(result);
-      }
+      struct r_vector_storage<int> {
+      typedef int type;
+      static const SEXPTYPE sexptype = INTSXP;
+      static type *data(SEXP x) { return INTEGER_POINTER(x); }
+      static const char *view_name() { return "swig_vector_int"; }
+      enum { direct = 1 };
     };
-    // vectors of int
     template <>
-      struct traits_from_ptr<std::vector<int> > {
-      static SEXP from (std::vector<int > *val, int owner = 0) {
+      struct r_vector_storage<unsigned int> {
+      typedef int type;
+      static const SEXPTYPE sexptype = INTSXP;
+      static type *data(SEXP x) { return INTEGER_POINTER(x); }
+      static const char *view_name() { return "swig_vector_unsigned_int"; }
+      enum { direct = 0 };
+    };
+
+    template <typename S, typename T>
+      inline void copy_numbers(const S *src, size_t n, T *dst) {
+      std::copy(src, src + n, dst);
+    }
+    inline void copy_numbers(const double *src, size_t n, double *dst) {
+      memcpy(dst, src, n * sizeof(double));
+    }
+    inline void copy_numbers(const int *src, size_t n, int *dst) {
+      memcpy(dst, src, n * sizeof(int));
+    }
+
+    template <typename T>
+      struct traits_numeric_vector {
+      typedef r_vector_storage<T> storage;
+
+      static SEXP from(const std::vector<T> &val) {
         SEXP result;
-        PROTECT(result = Rf_allocVector(INTSXP, val->size()));
-        for (unsigned pos = 0; pos < val->size(); pos++)
-          {
-            INTEGER_POINTER(result)[pos] = ((*val)[pos]);
-          }
+        PROTECT(result = Rf_allocVector(storage::sexptype, val.size()));
+        if (!val.empty())
+          copy_numbers(&val[0], val.size(), storage::data(result));
         UNPROTECT(1);
         return(result);
       }
+
+      static SEXP from(std::vector<T> *val, int owner = 0) {
+        SEXP result = from(*val);
+        if (owner)
+          delete val;
+        return(result);
+      }
+
+      static int asptr(SEXP obj, std::vector<T> **val) {
+        if (val) {
+          SEXP coerced;
+          PROTECT(coerced = Rf_coerceVector(obj, storage::sexptype));
+          size_t sexpsz = Rf_length(coerced);
+          std::vector<T> *p = new std::vector<T>(sexpsz);
+          if (sexpsz)
+            copy_numbers(storage::data(coerced), sexpsz, &(*p)[0]);
+          UNPROTECT(1);
+          *val = p;
+        }
+        return SWIG_NEWOBJ;
+      }
     };
 
+    // vectors of doubles, floats, unsigned ints and ints
+    template <>
+      struct traits_from<std::vector<double> > : traits_numeric_vector<double> {};
+    template <>
+      struct traits_from_ptr<std::vector<double> > : traits_numeric_vector<double> {};
+    template <>
+      struct traits_from<std::vector<float> > : traits_numeric_vector<float> {};
+    template <>
+      struct traits_from_ptr<std::vector<float> > : traits_numeric_vector<float> {};
+    template <>
+      struct traits_from<std::vector<unsigned int> > : traits_numeric_vector<unsigned int> {};
+    template <>
+      struct traits_from_ptr<std::vector<unsigned int> > : traits_numeric_vector<unsigned int> {};
+    template <>
+      struct traits_from<std::vector<int> > : traits_numeric_vector<int> {};
+    template <>
+      struct traits_from_ptr<std::vector<int> > : traits_numeric_vector<int> {};
+
     // vectors of bool
     template <>
       struct traits_from_ptr<std::vector<bool> > {
@@ -103,89 +150,13 @@
     };
 
     template <>
-  struct traits_asptr < std::vector<double> > {
-    static int asptr(SEXP obj, std::vector<double> **val) {
-      std::vector<double> *p;
-      // not sure how to check the size of the SEXP obj is correct
-      unsigned int sexpsz = Rf_length(obj);
-      p = new std::vector<double>(sexpsz);
-      double *S = NUMERIC_POINTER(obj);
-      for (unsigned pos = 0; pos < p->size(); pos++)
-        {
-          (*p)[pos] = static_cast<double>(S[pos]);
-        }
-      int res = SWIG_OK;
-      if (SWIG_IsOK(res)) {
-        if (val) *val = p;
-      }
-      return res;
-    }
-  };
-
+      struct traits_asptr < std::vector<double> > : traits_numeric_vector<double> {};
     template <>
-  struct traits_asptr < std::vector<float> > {
-    static int asptr(SEXP obj, std::vector<float> **val) {
-      std::vector<float> *p;
-      // not sure how to check the size of the SEXP obj is correct
-      unsigned int sexpsz = Rf_length(obj);
-      p = new std::vector<float>(sexpsz);
-      double *S = NUMERIC_POINTER(obj);
-      for (unsigned pos = 0; pos < p->size(); pos++)
-        {
-          (*p)[pos] = static_cast<double>(S[pos]);
-        }
-      int res = SWIG_OK;
-      if (SWIG_IsOK(res)) {
-        if (val) *val = p;
-      }
-      return res;
-    }
-  };
-
+      struct traits_asptr < std::vector<float> > : traits_numeric_vector<float> {};
     template <>
-  struct traits_asptr < std::vector<unsigned int> > {
-    static int asptr(SEXP obj, std::vector<unsigned int> **val) {
-      std::vector<unsigned int> *p;
-      unsigned int sexpsz = Rf_length(obj);
-      p = new std::vector<unsigned int>(sexpsz);
-      SEXP coerced;
-      PROTECT(coerced = Rf_coerceVector(obj, INTSXP));
-      int *S = INTEGER_POINTER(coerced);
-      for (unsigned pos = 0; pos < p->size(); pos++)
-        {
-          (*p)[pos] = static_cast<unsigned int>(S[pos]);
-        }
-      int res = SWIG_OK;
-      if (SWIG_IsOK(res)) {
-        if (val) *val = p;
-      }
-      UNPROTECT(1);
-      return res;
-    }
-  };
-
+      struct traits_asptr < std::vector<unsigned int> > : traits_numeric_vector<unsigned int> {};
     template <>
-  struct traits_asptr < std::vector<int> > {
-    static int asptr(SEXP obj, std::vector<int> **val) {
-      std::vector<int> *p;
-      // not sure how to check the size of the SEXP obj is correct
-      int sexpsz = Rf_length(obj);
-      p = new std::vector<int>(sexpsz);
-      SEXP coerced;
-      PROTECT(coerced = Rf_coerceVector(obj, INTSXP));
-      int *S = INTEGER_POINTER(coerced);
-      for (unsigned pos = 0; pos < p->size(); pos++)
-        {
-          (*p)[pos] = static_cast<int>(S[pos]);
-        }
-      int res = SWIG_OK;
-      if (SWIG_IsOK(res)) {
-        if (val) *val = p;
-      }
-      UNPROTECT(1);
-      return res;
-    }
-  };
+      struct traits_asptr < std::vector<int> > : traits_numeric_vector<int> {};
 
     template <>
   struct traits_asptr < std::vector<bool> > {
@@ -486,7 +457,135 @@
   }
 %}
 
-#define %swig_vector_methods(Type...) %swig_sequence_methods(Type)
+/*
+  Views: a std::vector<T> result handed to R without copying it.  With
+  R 3.6 or later the view is an ALTREP vector whose elements are read
+  from the heap allocated vector, which R deletes when it collects the
+  view.  Element types with a different layout from the R storage type
+  (float, unsigned int) are only copied into an R vector when R asks for
+  a pointer to the data, e.g. to modify it.  Older versions of R get an
+  ordinary copy.
+*/
+%fragment("StdVectorView","header",fragment="StdVectorTraits")
+%{
+#if R_VERSION >= R_Version(3,6,0)
+#include <R_ext/Rdynload.h>
+#include <R_ext/Altrep.h>
+#define SWIG_R_VECTOR_VIEW
+#endif
+
+  namespace swig {
+#ifdef SWIG_R_VECTOR_VIEW
+    inline R_altrep_class_t r_make_view_class(const char *name, double *) {
+      return R_make_altreal_class(name, "swig", NULL);
+    }
+    inline R_altrep_class_t r_make_view_class(const char *name, int *) {
+      return R_make_altinteger_class(name, "swig", NULL);
+    }
+    inline void r_set_view_elt(R_altrep_class_t cls, double (*elt)(SEXP, R_xlen_t)) {
+      R_set_altreal_Elt_method(cls, elt);
+    }
+    inline void r_set_view_elt(R_altrep_class_t cls, int (*elt)(SEXP, R_xlen_t)) {
+      R_set_altinteger_Elt_method(cls, elt);
+    }
+
+    // data1 is an external pointer owning the vector, data2 the R copy
+    // once the view has been materialized.
+    template <typename T>
+      struct r_vector_view {
+      typedef r_vector_storage<T> storage;
+      typedef typename storage::type value_type;
+
+      static std::vector<T> *vec(SEXP x) {
+        return static_cast<std::vector<T> *>(R_ExternalPtrAddr(R_altrep_data1(x)));
+      }
+
+      static void finalize(SEXP ptr) {
+        delete static_cast<std::vector<T> *>(R_ExternalPtrAddr(ptr));
+        R_ClearExternalPtr(ptr);
+      }
+
+      static SEXP materialize(SEXP x) {
+        SEXP copy = R_altrep_data2(x);
+        if (copy == R_NilValue) {
+          PROTECT(copy = traits_numeric_vector<T>::from(*vec(x)));
+          R_set_altrep_data2(x, copy);
+          UNPROTECT(1);
+          finalize(R_altrep_data1(x));
+        }
+        return copy;
+      }
+
+      static R_xlen_t length(SEXP x) {
+        SEXP copy = R_altrep_data2(x);
+        return copy == R_NilValue ? (R_xlen_t) vec(x)->size() : XLENGTH(copy);
+      }
+
+      static void *dataptr(SEXP x, Rboolean) {
+        const void *p = dataptr_or_null(x);
+        return p ? const_cast<void *>(p) : storage::data(materialize(x));
+      }
+
+      static const void *dataptr_or_null(SEXP x) {
+        SEXP copy = R_altrep_data2(x);
+        if (copy != R_NilValue)
+          return storage::data(copy);
+        std::vector<T> *v = vec(x);
+        return storage::direct && !v->empty() ? &(*v)[0] : NULL;
+      }
+
+      static value_type elt(SEXP x, R_xlen_t i) {
+        SEXP copy = R_altrep_data2(x);
+        return copy == R_NilValue ? (value_type)(*vec(x))[i] : storage::data(copy)[i];
+      }
+
+      static R_altrep_class_t view_class() {
+        static R_altrep_class_t cls;
+        static bool init = false;
+        if (!init) {
+          cls = r_make_view_class(storage::view_name(), (value_type *) 0);
+          R_set_altrep_Length_method(cls, length);
+          R_set_altvec_Dataptr_method(cls, dataptr);
+          R_set_altvec_Dataptr_or_null_method(cls, dataptr_or_null);
+          r_set_view_elt(cls, elt);
+          init = true;
+        }
+        return cls;
+      }
+
+      static SEXP from(std::vector<T> *val) {
+        SEXP ptr, result;
+        PROTECT(ptr = R_MakeExternalPtr(val, R_NilValue, R_NilValue));
+        R_RegisterCFinalizerEx(ptr, finalize, TRUE);
+        result = R_new_altrep(view_class(), ptr, R_NilValue);
+        UNPROTECT(1);
+        return(result);
+      }
+    };
+#else
+    template <typename T>
+      struct r_vector_view {
+      static SEXP from(std::vector<T> *val) {
+        return traits_numeric_vector<T>::from(val, 1);
+      }
+    };
+#endif
+
+    // Takes ownership of val.
+    template <typename T>
+      inline SEXP from_vector_view(std::vector<T> *val) {
+      return r_vector_view<T>::from(val);
+    }
+  }
+%}
+
+%define %swig_vector_methods(Type...)
+  %swig_sequence_methods(Type)
+  // convert results directly, not from a temporary copy
+  %typemap(out,noblock=1,fragment=SWIG_Traits_frag(Type)) Type, const Type {
+    %set_output(swig::from(%static_cast($1, const Type&)));
+  }
+%enddef
 #define %swig_vector_methods_val(Type...) %swig_sequence_methods_val(Type);
 
 %define %traits_type_name(Type...)
@@ -505,12 +604,36 @@
 
 %include <std/std_vector.i>
 
+/*
+  Numeric vectors are returned as R vectors converted straight from the
+  result.  Apply the VIEW typemaps to return a view of the result
+  instead, e.g.
+    %apply std::vector<double> VIEW { std::vector<double> simulate };
+*/
+%define %r_numeric_vector_typemaps(T...)
+%typemap(out,noblock=1,fragment="StdVectorTraits") std::vector<T>, const std::vector<T> {
+  %set_output(swig::from(%static_cast($1, const std::vector<T>&)));
+}
+%typemap(out,noblock=1,fragment="StdVectorTraits") const std::vector<T>& {
+  %set_output(swig::from(*$1));
+}
+%typemap(out,fragment="StdVectorView") std::vector<T> VIEW, const std::vector<T> VIEW {
+  std::vector<T> *view = new std::vector<T>();
+  view->swap(%static_cast($1, std::vector<T>&));
+  %set_output(swig::from_vector_view(view));
+}
+%typemap(out,noblock=1,fragment="StdVectorView") const std::vector<T>& VIEW {
+  %set_output(swig::from_vector_view(new std::vector<T>(*$1)));
+}
+%enddef
+
 %typemap_traits_ptr(SWIG_TYPECHECK_VECTOR, std::vector<double>)
 %traits_type_name(std::vector<double>)
 %typemap("rtypecheck") std::vector<double>, std::vector<double> const, std::vector<double> const&
     %{ is.numeric($arg) %}
 %typemap("rtype") std::vector<double> "numeric"
 %typemap("scoercein") std::vector<double>, std::vector<double> const, std::vector<double> const& "";
+%r_numeric_vector_typemaps(double)
 
 %typemap_traits_ptr(SWIG_TYPECHECK_VECTOR, std::vector<float>)
 %traits_type_name(std::vector<float>)
@@ -518,6 +641,7 @@
    %{ is.numeric($arg) %}
 %typemap("rtype") std::vector<float> "numeric"
 %typemap("scoercein") std::vector<double>, std::vector<float> const, std::vector<float> const& "";
+%r_numeric_vector_typemaps(float)
 
 %typemap_traits_ptr(SWIG_TYPECHECK_VECTOR, std::vector<bool>);
 %traits_type_name(std::vector<bool>);
@@ -532,6 +656,7 @@
    %{ is.integer($arg) || is.numeric($arg) %}
 %typemap("rtype") std::vector<int> "integer"
 %typemap("scoercein") std::vector<int> , std::vector<int> const, std::vector<int> const& "$input = as.integer($input);";
+%r_numeric_vector_typemaps(int)
 
 %typemap_traits_ptr(SWIG_TYPECHECK_VECTOR, std::vector<unsigned int>);
 %traits_type_name(std::vector<unsigned int>);
@@ -539,6 +664,7 @@
 %{ is.integer($arg) || is.numeric($arg) %}
 %typemap("rtype") std::vector<unsigned int> "integer"
 %typemap("scoercein") std::vector<unsigned int>, std::vector<unsigned int> const, std::vector<unsigned int> const& "$input = as.integer($input);";
+%r_numeric_vector_typemaps(unsigned int)
 
 %typemap_traits_ptr(SWIG_TYPECHECK_VECTOR, std::vector<std::vector<unsigned int> >);
 %traits_type_name(std::vector< std::vector<unsigned int> >);
@@ -581,6 +707,12 @@
 %typemap(scoerceout) std::vector<double>,
    std::vector<double> *,
    std::vector<double> &,
+   std::vector<float>,
+   std::vector<float> *,
+   std::vector<float> &,
+   std::vector<int>,
+   std::vector<int> *,
+   std::vector<int> &,
    std::vector<bool>,
    std::vector<bool> *,
    std::vector<bool> &,
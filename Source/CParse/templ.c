@@ -15,6 +15,7 @@
 #include "cparse.h"
 
 static int template_debug = 0;
+static Hash *partials_cache = 0;  /* partial specializations matched by template_locate() */
 
 
 const char *baselists[3];
@@ -312,6 +313,8 @@ int Swig_cparse_template_expand(Node *n, String *rname, ParmList *tparms, Symtab
   {
     Parm *tp = Getattr(n, "templateparms");
     Parm *p = tparms;
+    List *names = NewList();
+    List *dvalues = NewList();
     /*    Printf(stdout,"%s\n", ParmList_str_defaultargs(tp)); */
 
     if (tp) {
@@ -354,15 +357,9 @@ int Swig_cparse_template_expand(Node *n, String *rname, ParmList *tparms, Symtab
 	    String *s = Getitem(patchlist, i);
 	    Replace(s, name, dvalue, DOH_REPLACE_ID);
 	  }
-	  sz = Len(typelist);
-	  for (i = 0; i < sz; i++) {
-	    String *s = Getitem(typelist, i);
-	    /*      Replace(s,name,value, DOH_REPLACE_ID); */
-	    /*      Printf(stdout,"name = '%s', value = '%s', tbase = '%s', iname='%s' s = '%s' --> ", name, dvalue, tbase, iname, s); */
-	    SwigType_typename_replace(s, name, dvalue);
-	    SwigType_typename_replace(s, tbase, iname);
-	    /*      Printf(stdout,"'%s'\n", s); */
-	  }
+	  /* The types are patched below */
+	  Append(names, name);
+	  Append(dvalues, dvalue);
 
 	  tmp = NewStringf("#%s", name);
 	  tmpr = NewStringf("\"%s\"", valuestr);
@@ -384,15 +381,39 @@ int Swig_cparse_template_expand(Node *n, String *rname, ParmList *tparms, Symtab
 	if (!p)
 	  p = tp;
       }
-    } else {
-      /* No template parameters at all.  This could be a specialization */
-      int i, sz;
+    }
+
+    /* Patch the types with all of the template parameters, then replace the template name.
+       The same types occur many times in a template, so each distinct type is only patched once */
+    {
+      Hash *patched = NewHash();
+      int i, j, sz, nsz;
       sz = Len(typelist);
+      nsz = Len(names);
       for (i = 0; i < sz; i++) {
 	String *s = Getitem(typelist, i);
-	SwigType_typename_replace(s, tbase, iname);
+	String *ps = Getattr(patched, s);
+	if (ps) {
+	  Clear(s);
+	  Append(s, ps);
+	} else {
+	  String *key = Copy(s);
+	  for (j = 0; j < nsz; j++) {
+	    /*      Printf(stdout,"name = '%s', value = '%s', tbase = '%s', iname='%s' s = '%s' --> ", Getitem(names, j), Getitem(dvalues, j), tbase, iname, s); */
+	    SwigType_typename_replace(s, Getitem(names, j), Getitem(dvalues, j));
+	    /*      Printf(stdout,"'%s'\n", s); */
+	  }
+	  SwigType_typename_replace(s, tbase, iname);
+	  ps = Copy(s);
+	  Setattr(patched, key, ps);
+	  Delete(ps);
+	  Delete(key);
+	}
       }
+      Delete(patched);
     }
+    Delete(dvalues);
+    Delete(names);
   }
 
   /* Patch bases */
@@ -427,20 +448,18 @@ typedef enum { ExactNoMatch = -2, PartiallySpecializedNoMatch = -1, PartiallySpe
  * Template argument deduction - check if a template type matches a partially specialized 
  * template parameter type. Typedef reduce 'partial_parm_type' to see if it matches 'type'.
  *
- * type - template parameter type to match against
+ * ty - typedef reduced template parameter type to match against
  * partial_parm_type - partially specialized template type - a possible match
  * partial_parm_type_base - base type of partial_parm_type
- * tscope - template scope
  * specialization_priority - (output) contains a value indicating how good the match is 
  *   (higher is better) only set if return is set to PartiallySpecializedMatch or ExactMatch.
  * ----------------------------------------------------------------------------- */
 
-static EMatch does_parm_match(SwigType *type, SwigType *partial_parm_type, const char *partial_parm_type_base, Symtab *tscope, int *specialization_priority) {
+static EMatch does_parm_match(SwigType *ty, SwigType *partial_parm_type, const char *partial_parm_type_base, int *specialization_priority) {
   static const int EXACT_MATCH_PRIORITY = 99999; /* a number bigger than the length of any conceivable type */
   int matches;
   int substitutions;
   EMatch match;
-  SwigType *ty = Swig_symbol_typedef_reduce(type, tscope);
   String *base = SwigType_base(ty);
   SwigType *t = Copy(partial_parm_type);
   substitutions = Replaceid(t, partial_parm_type_base, base); /* eg: Replaceid("p.$1", "$1", "int") returns t="p.int" */
@@ -475,14 +494,174 @@ static EMatch does_parm_match(SwigType *type, SwigType *partial_parm_type, const
       *specialization_priority = EXACT_MATCH_PRIORITY; /* exact matches always take precedence */
   }
   /*
-  Printf(stdout, "      does_parm_match %2d %5d [%s] [%s]\n", match, *specialization_priority, type, partial_parm_type);
+  Printf(stdout, "      does_parm_match %2d %5d [%s] [%s]\n", match, *specialization_priority, ty, partial_parm_type);
   */
   Delete(t);
   Delete(base);
-  Delete(ty);
   return match;
 }
 
+/* -----------------------------------------------------------------------------
+ * template_partials_match()
+ *
+ * Find the partial specializations in 'partials' that best match the template
+ * arguments 'parms'. 'reduced' holds the typedef reduced types of 'parms'.
+ * ----------------------------------------------------------------------------- */
+
+static List *template_partials_match(List *partials, Parm *parms, List *reduced) {
+  List *possiblepartials = NewList();
+  int parms_len = ParmList_len(parms);
+  int max_possible_partials = Len(partials);
+  int *priorities_matrix;
+  int posslen;
+
+  /* Rank each template parameter against the desired template parameters then build a matrix of best matches */
+  {
+    char tmp[32];
+    Iterator pi;
+    int *priorities_row;
+    priorities_matrix = (int *)malloc(sizeof(int) * max_possible_partials * parms_len); /* slightly wasteful allocation for max possible matches */
+    priorities_row = priorities_matrix;
+    for (pi = First(partials); pi.item; pi = Next(pi)) {
+      Parm *p = parms;
+      int all_parameters_match = 1;
+      int i = 1;
+      Parm *partialparms = Getattr(pi.item, "partialparms");
+      Parm *pp = partialparms;
+      String *templcsymname = Getattr(pi.item, "templcsymname");
+      if (template_debug) {
+	Printf(stdout, "    checking match: '%s' (partial specialization)\n", templcsymname);
+      }
+      if (ParmList_len(partialparms) == parms_len) {
+	while (p && pp) {
+	  SwigType *t = Getitem(reduced, i - 1);
+	  sprintf(tmp, "$%d", i);
+	  if (Len(t) > 0) {
+	    EMatch match = does_parm_match(t, Getattr(pp, "type"), tmp, priorities_row + i - 1);
+	    if (match < (int)PartiallySpecializedMatch) {
+	      all_parameters_match = 0;
+	      break;
+	    }
+	  }
+	  i++;
+	  p = nextSibling(p);
+	  pp = nextSibling(pp);
+	}
+	if (all_parameters_match) {
+	  Append(possiblepartials, pi.item);
+	  priorities_row += parms_len;
+	}
+      }
+    }
+  }
+
+  posslen = Len(possiblepartials);
+  if (template_debug) {
+    int i;
+    if (posslen == 0)
+      Printf(stdout, "    matched partials: NONE\n");
+    else if (posslen == 1)
+      Printf(stdout, "    chosen partial: '%s'\n", Getattr(Getitem(possiblepartials, 0), "templcsymname"));
+    else {
+      Printf(stdout, "    possibly matched partials:\n");
+      for (i = 0; i < posslen; i++) {
+	Printf(stdout, "      '%s'\n", Getattr(Getitem(possiblepartials, i), "templcsymname"));
+      }
+    }
+  }
+
+  if (posslen > 1) {
+    /* Now go through all the possibly matched partial specialization templates and look for a non-ambiguous match.
+     * Exact matches rank the highest and deduced parameters are ranked by how specialized they are, eg looking for
+     * a match to const int *, the following rank (highest to lowest):
+     *   const int * (exact match)
+     *   const T *
+     *   T *
+     *   T
+     *
+     *   An ambiguous example when attempting to match as either specialization could match: %template() X<int *, double *>;
+     *   template<typename T1, typename T2> X class {};  // primary template
+     *   template<typename T1> X<T1, double *> class {}; // specialization (1)
+     *   template<typename T2> X<int *, T2> class {};    // specialization (2)
+     */
+    if (template_debug) {
+      int row, col;
+      Printf(stdout, "      parameter priorities matrix (%d parms):\n", parms_len);
+      for (row = 0; row < posslen; row++) {
+	int *priorities_row = priorities_matrix + row*parms_len;
+	Printf(stdout, "        ");
+	for (col = 0; col < parms_len; col++) {
+	  Printf(stdout, "%5d ", priorities_row[col]);
+	}
+	Printf(stdout, "\n");
+      }
+    }
+    {
+      int row, col;
+      /* Printf(stdout, "      parameter priorities inverse matrix (%d parms):\n", parms_len); */
+      for (col = 0; col < parms_len; col++) {
+	int *priorities_col = priorities_matrix + col;
+	int maxpriority = -1;
+	/* 
+	   Printf(stdout, "max_possible_partials: %d col:%d\n", max_possible_partials, col);
+	   Printf(stdout, "        ");
+	   */
+	/* determine the highest rank for this nth parameter */
+	for (row = 0; row < posslen; row++) {
+	  int *element_ptr = priorities_col + row*parms_len;
+	  int priority = *element_ptr;
+	  if (priority > maxpriority)
+	    maxpriority = priority;
+	  /* Printf(stdout, "%5d ", priority); */
+	}
+	/* Printf(stdout, "\n"); */
+	/* flag all the parameters which equal the highest rank */
+	for (row = 0; row < posslen; row++) {
+	  int *element_ptr = priorities_col + row*parms_len;
+	  int priority = *element_ptr;
+	  *element_ptr = (priority >= maxpriority) ? 1 : 0;
+	}
+      }
+    }
+    {
+      int row, col;
+      Iterator pi = First(possiblepartials);
+      Node *chosenpartials = NewList();
+      if (template_debug)
+	Printf(stdout, "      priority flags matrix:\n");
+      for (row = 0; row < posslen; row++) {
+	int *priorities_row = priorities_matrix + row*parms_len;
+	int highest_count = 0; /* count of highest priority parameters */
+	for (col = 0; col < parms_len; col++) {
+	  highest_count += priorities_row[col];
+	}
+	if (template_debug) {
+	  Printf(stdout, "        ");
+	  for (col = 0; col < parms_len; col++) {
+	    Printf(stdout, "%5d ", priorities_row[col]);
+	  }
+	  Printf(stdout, "\n");
+	}
+	if (highest_count == parms_len) {
+	  Append(chosenpartials, pi.item);
+	}
+	pi = Next(pi);
+      }
+      if (Len(chosenpartials) > 0) {
+	/* one or more best match found */
+	Delete(possiblepartials);
+	possiblepartials = chosenpartials;
+	posslen = Len(possiblepartials);
+      } else {
+	/* no best match found */
+	Delete(chosenpartials);
+      }
+    }
+  }
+  free(priorities_matrix);
+  return possiblepartials;
+}
+
 /* -----------------------------------------------------------------------------
  * template_locate()
  *
@@ -499,8 +678,6 @@ static Node *template_locate(String *name, Parm *tparms, Symtab *tscope) {
   Parm *parms = 0;
   Parm *targs;
   ParmList *expandedparms;
-  int *priorities_matrix = 0;
-  int max_possible_partials = 0;
   int posslen = 0;
 
   /* Search for primary (unspecialized) template */
@@ -589,163 +766,47 @@ static Node *template_locate(String *name, Parm *tparms, Symtab *tscope) {
      * only (1) is really supported for partial specializations
      */
 
-    /* Rank each template parameter against the desired template parameters then build a matrix of best matches */
-    possiblepartials = NewList();
     {
-      char tmp[32];
-      List *partials;
-
-      partials = Getattr(templ, "partials"); /* note that these partial specializations do not include explicit specializations */
+      List *partials = Getattr(templ, "partials"); /* note that these partial specializations do not include explicit specializations */
       if (partials) {
-	Iterator pi;
-	int parms_len = ParmList_len(parms);
-	int *priorities_row;
-	max_possible_partials = Len(partials);
-	priorities_matrix = (int *)malloc(sizeof(int) * max_possible_partials * parms_len); /* slightly wasteful allocation for max possible matches */
-	priorities_row = priorities_matrix;
-	for (pi = First(partials); pi.item; pi = Next(pi)) {
-	  Parm *p = parms;
-	  int all_parameters_match = 1;
-	  int i = 1;
-	  Parm *partialparms = Getattr(pi.item, "partialparms");
-	  Parm *pp = partialparms;
-	  String *templcsymname = Getattr(pi.item, "templcsymname");
-	  if (template_debug) {
-	    Printf(stdout, "    checking match: '%s' (partial specialization)\n", templcsymname);
-	  }
-	  if (ParmList_len(partialparms) == parms_len) {
-	    while (p && pp) {
-	      SwigType *t;
-	      sprintf(tmp, "$%d", i);
-	      t = Getattr(p, "type");
-	      if (!t)
-		t = Getattr(p, "value");
-	      if (t) {
-		EMatch match = does_parm_match(t, Getattr(pp, "type"), tmp, tscope, priorities_row + i - 1);
-		if (match < (int)PartiallySpecializedMatch) {
-		  all_parameters_match = 0;
-		  break;
-		}
-	      }
-	      i++;
-	      p = nextSibling(p);
-	      pp = nextSibling(pp);
-	    }
-	    if (all_parameters_match) {
-	      Append(possiblepartials, pi.item);
-	      priorities_row += parms_len;
-	    }
-	  }
+	/* The match only depends on the typedef reduced template arguments and on the partial specializations
+	 * of the primary template, so it is done once for each set of reduced arguments */
+	String *key = NewStringf("%p", templ);
+	List *reduced = NewList();
+	Hash *cached;
+	for (p = parms; p; p = nextSibling(p)) {
+	  SwigType *t = Getattr(p, "type");
+	  SwigType *ty;
+	  if (!t)
+	    t = Getattr(p, "value");
+	  ty = t ? Swig_symbol_typedef_reduce(t, tscope) : NewStringEmpty();
+	  Printf(key, "|%s", ty);
+	  Append(reduced, ty);
+	  Delete(ty);
 	}
-      }
-    }
-
-    posslen = Len(possiblepartials);
-    if (template_debug) {
-      int i;
-      if (posslen == 0)
-	Printf(stdout, "    matched partials: NONE\n");
-      else if (posslen == 1)
-	Printf(stdout, "    chosen partial: '%s'\n", Getattr(Getitem(possiblepartials, 0), "templcsymname"));
-      else {
-	Printf(stdout, "    possibly matched partials:\n");
-	for (i = 0; i < posslen; i++) {
-	  Printf(stdout, "      '%s'\n", Getattr(Getitem(possiblepartials, i), "templcsymname"));
-	}
-      }
-    }
-
-    if (posslen > 1) {
-      /* Now go through all the possibly matched partial specialization templates and look for a non-ambiguous match.
-       * Exact matches rank the highest and deduced parameters are ranked by how specialized they are, eg looking for
-       * a match to const int *, the following rank (highest to lowest):
-       *   const int * (exact match)
-       *   const T *
-       *   T *
-       *   T
-       *
-       *   An ambiguous example when attempting to match as either specialization could match: %template() X<int *, double *>;
-       *   template<typename T1, typename T2> X class {};  // primary template
-       *   template<typename T1> X<T1, double *> class {}; // specialization (1)
-       *   template<typename T2> X<int *, T2> class {};    // specialization (2)
-       */
-      if (template_debug) {
-	int row, col;
-	int parms_len = ParmList_len(parms);
-	Printf(stdout, "      parameter priorities matrix (%d parms):\n", parms_len);
-	for (row = 0; row < posslen; row++) {
-	  int *priorities_row = priorities_matrix + row*parms_len;
-	  Printf(stdout, "        ");
-	  for (col = 0; col < parms_len; col++) {
-	    Printf(stdout, "%5d ", priorities_row[col]);
-	  }
-	  Printf(stdout, "\n");
-	}
-      }
-      {
-	int row, col;
-	int parms_len = ParmList_len(parms);
-	/* Printf(stdout, "      parameter priorities inverse matrix (%d parms):\n", parms_len); */
-	for (col = 0; col < parms_len; col++) {
-	  int *priorities_col = priorities_matrix + col;
-	  int maxpriority = -1;
-	  /* 
-	     Printf(stdout, "max_possible_partials: %d col:%d\n", max_possible_partials, col);
-	     Printf(stdout, "        ");
-	     */
-	  /* determine the highest rank for this nth parameter */
-	  for (row = 0; row < posslen; row++) {
-	    int *element_ptr = priorities_col + row*parms_len;
-	    int priority = *element_ptr;
-	    if (priority > maxpriority)
-	      maxpriority = priority;
-	    /* Printf(stdout, "%5d ", priority); */
-	  }
-	  /* Printf(stdout, "\n"); */
-	  /* flag all the parameters which equal the highest rank */
-	  for (row = 0; row < posslen; row++) {
-	    int *element_ptr = priorities_col + row*parms_len;
-	    int priority = *element_ptr;
-	    *element_ptr = (priority >= maxpriority) ? 1 : 0;
-	  }
-	}
-      }
-      {
-	int row, col;
-	int parms_len = ParmList_len(parms);
-	Iterator pi = First(possiblepartials);
-	Node *chosenpartials = NewList();
-	if (template_debug)
-	  Printf(stdout, "      priority flags matrix:\n");
-	for (row = 0; row < posslen; row++) {
-	  int *priorities_row = priorities_matrix + row*parms_len;
-	  int highest_count = 0; /* count of highest priority parameters */
-	  for (col = 0; col < parms_len; col++) {
-	    highest_count += priorities_row[col];
-	  }
+	if (!partials_cache)
+	  partials_cache = NewHash();
+	cached = Getattr(partials_cache, key);
+	if (cached && GetInt(cached, "count") == Len(partials)) {
+	  possiblepartials = Copy(Getattr(cached, "matches"));
 	  if (template_debug) {
-	    Printf(stdout, "        ");
-	    for (col = 0; col < parms_len; col++) {
-	      Printf(stdout, "%5d ", priorities_row[col]);
-	    }
-	    Printf(stdout, "\n");
-	  }
-	  if (highest_count == parms_len) {
-	    Append(chosenpartials, pi.item);
+	    Printf(stdout, "    partial specializations previously matched: %d\n", Len(possiblepartials));
 	  }
-	  pi = Next(pi);
-	}
-	if (Len(chosenpartials) > 0) {
-	  /* one or more best match found */
-	  Delete(possiblepartials);
-	  possiblepartials = chosenpartials;
-	  posslen = Len(possiblepartials);
 	} else {
-	  /* no best match found */
-	  Delete(chosenpartials);
+	  possiblepartials = template_partials_match(partials, parms, reduced);
+	  cached = NewHash();
+	  SetInt(cached, "count", Len(partials));
+	  Setattr(cached, "matches", possiblepartials);
+	  Setattr(partials_cache, key, cached);
+	  Delete(cached);
 	}
+	Delete(reduced);
+	Delete(key);
+      } else {
+	possiblepartials = NewList();
       }
     }
+    posslen = Len(possiblepartials);
 
     if (posslen > 0) {
       String *s = Getattr(Getitem(possiblepartials, 0), "templcsymname");
@@ -799,7 +860,6 @@ success:
     Printf(stdout, "    chosen template:'%s'\n", Getattr(n, "name"));
   }
   Delete(parms);
-  free(priorities_matrix);
   return n;
 }
 
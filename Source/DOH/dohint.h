@@ -128,5 +128,6 @@ typedef struct {
 
 extern DOH *DohObjMalloc(DohObjInfo *type, void *data);	/* Allocate a DOH object */
 extern void DohObjFree(DOH *ptr);	/* Free a DOH object     */
+extern int DohHashChains(DOH *ho, int *buckets, int *used, int *longest);	/* Hash table chain statistics */
 
 #endif				/* DOHINT_H */
@@ -564,6 +564,33 @@ DohObjInfo DohHashType = {
   0,
 };
 
+/* -----------------------------------------------------------------------------
+ * DohHashChains()
+ *
+ * Return the number of items, buckets, used buckets and the longest chain of a
+ * hash table.  Used by DohMemoryDebug() to show how well the keys are spread.
+ * ----------------------------------------------------------------------------- */
+
+int DohHashChains(DOH *ho, int *buckets, int *used, int *longest) {
+  Hash *h = (Hash *) ObjData(ho);
+  HashNode *n;
+  int i;
+
+  *buckets = h->hashsize;
+  *used = 0;
+  *longest = 0;
+  for (i = 0; i < h->hashsize; i++) {
+    int len = 0;
+    for (n = h->hashtable[i]; n; n = n->next)
+      len++;
+    if (len)
+      (*used)++;
+    if (len > *longest)
+      *longest = len;
+  }
+  return h->nitems;
+}
+
 /* -----------------------------------------------------------------------------
  * NewHash()
  *
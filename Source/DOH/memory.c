@@ -170,6 +170,8 @@ void DohObjFree(DOH *ptr) {
  * Display memory usage statistics
  * ---------------------------------------------------------------------- */
 
+#define MAX_HASH_STATS 10
+
 void DohMemoryDebug(void) {
   extern DohObjInfo DohStringType;
   extern DohObjInfo DohListType;
@@ -218,6 +220,36 @@ void DohMemoryDebug(void) {
   printf("    Lists     : %d\n", numlist);
   printf("    Hashes    : %d\n", numhash);
 
+  /* The largest hashes and how long their chains are */
+  {
+    DohBase *largest[MAX_HASH_STATS];
+    int nlargest = 0;
+    int i, j;
+    for (p = Pools; p; p = p->next) {
+      for (i = 0; i < p->len; i++) {
+	DohBase *b = &p->ptr[i];
+	if ((b->refcount > 0) && (b->type == &DohHashType)) {
+	  int n = Len(b);
+	  for (j = nlargest; (j > 0) && (Len(largest[j - 1]) < n); j--) {
+	    if (j < MAX_HASH_STATS)
+	      largest[j] = largest[j - 1];
+	  }
+	  if (j < MAX_HASH_STATS) {
+	    largest[j] = b;
+	    if (nlargest < MAX_HASH_STATS)
+	      nlargest++;
+	  }
+	}
+      }
+    }
+    printf("\nLargest hashes\n");
+    for (i = 0; i < nlargest; i++) {
+      int buckets, used, longest;
+      int items = DohHashChains(largest[i], &buckets, &used, &longest);
+      printf("    Hash %8p: items = %8d, buckets = %8d, average chain = %5.2f, longest chain = %4d\n", (void *) largest[i], items, buckets, used ? (double) items / used : 0.0, longest);
+    }
+  }
+
 #if 0
   p = Pools;
   while (p) {
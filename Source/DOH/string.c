@@ -180,23 +180,48 @@ static int String_hash(DOH *so) {
   if (s->hashkey >= 0) {
     return s->hashkey;
   } else {
-    register char *c = s->str;
-    register int len = s->len > 50 ? 50 : s->len;
-    register int h = 0;
-    register int mlen = len >> 2;
-    register int i = mlen;
-    for (; i; --i) {
-      h = (h << 5) + *(c++);
-      h = (h << 5) + *(c++);
-      h = (h << 5) + *(c++);
-      h = (h << 5) + *(c++);
+    /* MurmurHash3 (32 bit) of the whole string.  Types and mangled names often
+       share a long prefix, so every character has to contribute.  The empty
+       string hashes to 0, as assumed by NewStringEmpty(). */
+    register const unsigned char *c = (const unsigned char *) s->str;
+    register int len = s->len;
+    register unsigned int h = 0;
+    register unsigned int k;
+    register int i;
+    for (i = len >> 2; i; --i) {
+      k = (unsigned int) c[0] | ((unsigned int) c[1] << 8) | ((unsigned int) c[2] << 16) | ((unsigned int) c[3] << 24);
+      c += 4;
+      k *= 0xcc9e2d51U;
+      k = (k << 15) | ((k & 0xffffffffU) >> 17);
+      k *= 0x1b873593U;
+      h ^= k;
+      h = (h << 13) | ((h & 0xffffffffU) >> 19);
+      h = h * 5 + 0xe6546b64U;
     }
-    for (i = len - (mlen << 2); i; --i) {
-      h = (h << 5) + *(c++);
+    k = 0;
+    switch (len & 3) {
+    case 3:
+      k ^= (unsigned int) c[2] << 16;
+      /* Falls through */
+    case 2:
+      k ^= (unsigned int) c[1] << 8;
+      /* Falls through */
+    case 1:
+      k ^= (unsigned int) c[0];
+      k *= 0xcc9e2d51U;
+      k = (k << 15) | ((k & 0xffffffffU) >> 17);
+      k *= 0x1b873593U;
+      h ^= k;
     }
-    h &= 0x7fffffff;
-    s->hashkey = h;
-    return h;
+    h ^= (unsigned int) len;
+    h &= 0xffffffffU;
+    h ^= h >> 16;
+    h = (h * 0x85ebca6bU) & 0xffffffffU;
+    h ^= h >> 13;
+    h = (h * 0xc2b2ae35U) & 0xffffffffU;
+    h ^= h >> 16;
+    s->hashkey = (int) (h & 0x7fffffff);
+    return s->hashkey;
   }
 }
 
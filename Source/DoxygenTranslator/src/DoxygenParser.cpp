@@ -25,8 +25,8 @@ using std::cout;
 using std::endl;
 
 // Define static class members
-DoxygenParser::DoxyCommandsMap DoxygenParser::doxygenCommands;
-std::set<std::string> DoxygenParser::doxygenSectionIndicators;
+DoxygenParser::DoxyCommand DoxygenParser::doxygenCommands[DoxygenParser::DOXY_COMMANDS_TABLE_SIZE];
+bool DoxygenParser::doxygenCommandsFilled = false;
 
 const int TOKENSPERLINE = 8; //change this to change the printing behaviour of the token list
 const std::string END_HTML_TAG_MARK("/");
@@ -41,55 +41,116 @@ DoxygenParser::~DoxygenParser()
 {
 }
 
+/*
+ * Case insensitive FNV-1a hash of a command name.
+ */
+size_t DoxygenParser::hashCommand(const char *name, size_t len)
+{
+  size_t h = 2166136261U;
+  for (size_t i = 0; i < len; i++) {
+    h ^= (unsigned char)tolower(name[i]);
+    h *= 16777619U;
+  }
+  return h;
+}
+
+/*
+ * Finds the table entry of a command, ignoring case. Returns 0 if it is
+ * not there, unless 'insert' is set, when the empty entry for it is
+ * returned.
+ */
+DoxygenParser::DoxyCommand *DoxygenParser::lookupCommand(const char *name,
+                                                         size_t len,
+                                                         bool insert)
+{
+  size_t idx = hashCommand(name, len) & (DOXY_COMMANDS_TABLE_SIZE - 1);
+
+  while (doxygenCommands[idx].name) {
+    DoxyCommand *cmd = &doxygenCommands[idx];
+    if (cmd->len == len) {
+      size_t i = 0;
+      while (i < len && tolower(name[i]) == cmd->name[i])
+        i++;
+      if (i == len)
+        return cmd;
+    }
+    idx = (idx + 1) & (DOXY_COMMANDS_TABLE_SIZE - 1);
+  }
+  return insert ? &doxygenCommands[idx] : 0;
+}
+
+void DoxygenParser::addCommandToTable(const char *name, int commandType)
+{
+  size_t len = strlen(name);
+  DoxyCommand *cmd = lookupCommand(name, len, true);
+
+  if (!cmd->name) {
+    cmd->name = name;
+    cmd->len = len;
+    cmd->isSectionIndicator = false;
+  }
+  // commands listed in more than one table get the last one
+  cmd->commandType = commandType;
+}
+
 void DoxygenParser::fillTables()
 {
   // run it only once
-  if (doxygenCommands.size())
+  if (doxygenCommandsFilled)
     return;
+  doxygenCommandsFilled = true;
 
   // fill in tables with data from DxygenCommands.h
   for (int i = 0; i < simpleCommandsSize; i++)
-    doxygenCommands[simpleCommands[i]] = SIMPLECOMMAND;
+    addCommandToTable(simpleCommands[i], SIMPLECOMMAND);
 
   for (int i = 0; i < commandWordsSize; i++)
-    doxygenCommands[commandWords[i]] = COMMANDWORD;
+    addCommandToTable(commandWords[i], COMMANDWORD);
 
   for (int i = 0; i < commandLinesSize; i++)
-    doxygenCommands[commandLines[i]] = COMMANDLINE;
+    addCommandToTable(commandLines[i], COMMANDLINE);
 
   for (int i = 0; i < commandParagraphSize; i++)
-    doxygenCommands[commandParagraph[i]] = COMMANDPARAGRAPH;
+    addCommandToTable(commandParagraph[i], COMMANDPARAGRAPH);
 
   for (int i = 0; i < commandEndCommandsSize; i++)
-    doxygenCommands[commandEndCommands[i]] = COMMANDENDCOMMAND;
+    addCommandToTable(commandEndCommands[i], COMMANDENDCOMMAND);
 
   for (int i = 0; i < commandWordParagraphsSize; i++)
-    doxygenCommands[commandWordParagraphs[i]] = COMMANDWORDPARAGRAPH;
+    addCommandToTable(commandWordParagraphs[i], COMMANDWORDPARAGRAPH);
 
   for (int i = 0; i < commandWordLinesSize; i++)
-    doxygenCommands[commandWordLines[i]] = COMMANDWORDLINE;
+    addCommandToTable(commandWordLines[i], COMMANDWORDLINE);
 
   for (int i = 0; i < commandWordOWordOWordsSize; i++)
-    doxygenCommands[commandWordOWordOWords[i]] = COMMANDWORDOWORDWORD;
+    addCommandToTable(commandWordOWordOWords[i], COMMANDWORDOWORDWORD);
 
   for (int i = 0; i < commandOWordsSize; i++)
-    doxygenCommands[commandOWords[i]] = COMMANDOWORD;
+    addCommandToTable(commandOWords[i], COMMANDOWORD);
 
   for (int i = 0; i < commandErrorThrowingsSize; i++)
-    doxygenCommands[commandErrorThrowings[i]] = COMMANDERRORTHROW;
+    addCommandToTable(commandErrorThrowings[i], COMMANDERRORTHROW);
 
   for (int i = 0; i < commandUniquesSize; i++)
-      doxygenCommands[commandUniques[i]] = COMMANDUNIQUE;
+    addCommandToTable(commandUniques[i], COMMANDUNIQUE);
 
   for (int i = 0; i < commandHtmlSize; i++)
-    doxygenCommands[commandHtml[i]] = COMMAND_HTML;
+    addCommandToTable(commandHtml[i], COMMAND_HTML);
 
   for (int i = 0; i < commandHtmlEntitiesSize; i++)
-    doxygenCommands[commandHtmlEntities[i]] = COMMAND_HTML_ENTITY;
-
-  // fill section indicators command set
-  for (int i = 0; i < sectionIndicatorsSize; i++)
-    doxygenSectionIndicators.insert(sectionIndicators[i]);
+    addCommandToTable(commandHtmlEntities[i], COMMAND_HTML_ENTITY);
+
+  // mark section indicator commands
+  for (int i = 0; i < sectionIndicatorsSize; i++) {
+    const char *name = sectionIndicators[i];
+    DoxyCommand *cmd = lookupCommand(name, strlen(name), true);
+    if (!cmd->name) {
+      cmd->name = name;
+      cmd->len = strlen(name);
+      cmd->commandType = -1;
+    }
+    cmd->isSectionIndicator = true;
+  }
 }
 
 std::string DoxygenParser::stringToLower(const std::string &stringToConvert)
@@ -109,19 +170,17 @@ bool DoxygenParser::findCommand(const std::string &smallString)
   // I'm not sure if we can really do so, because there are different commands
   // in doxygenCommands and original commandArray
 
-  std::map<std::string, DoxyCommandEnum>::iterator it = doxygenCommands.find(
-      stringToLower(smallString));
+  DoxyCommand *cmd = lookupCommand(smallString.data(), smallString.size());
 
-  return it != doxygenCommands.end(); // returns true if command was found
+  return cmd && cmd->commandType != -1; // returns true if command was found
 }
 
 bool DoxygenParser::isSectionIndicator(const std::string &smallString)
 {
 
-  std::set<std::string>::iterator it = doxygenSectionIndicators.find(
-      stringToLower(smallString));
+  DoxyCommand *cmd = lookupCommand(smallString.data(), smallString.size());
 
-  return it != doxygenSectionIndicators.end();
+  return cmd && cmd->isSectionIndicator;
 }
 
 void DoxygenParser::printTree(const DoxygenEntityList &rootList)
@@ -136,12 +195,11 @@ void DoxygenParser::printTree(const DoxygenEntityList &rootList)
 int DoxygenParser::commandBelongs(const std::string &theCommand)
 {
 
-  std::string smallString = stringToLower(theCommand);
   //cout << " Looking for command " << theCommand << endl;
-  DoxyCommandsMapIt it = doxygenCommands.find(smallString);
+  DoxyCommand *cmd = lookupCommand(theCommand.data(), theCommand.size());
 
-  if (it != doxygenCommands.end()) {
-    return it->second;
+  if (cmd && cmd->commandType != -1) {
+    return cmd->commandType;
   }
   return 0;
 }
@@ -162,8 +220,7 @@ bool DoxygenParser::isEndOfLine()
   if (m_tokenListIt == m_tokenList.end()) {
     return false;
   }
-  Token nextToken = *m_tokenListIt;
-  return nextToken.m_tokenType == END_LINE;
+  return m_tokenListIt->m_tokenType == END_LINE;
 }
 
 void DoxygenParser::skipWhitespaceTokens()
@@ -174,7 +231,7 @@ void DoxygenParser::skipWhitespaceTokens()
 
   while (m_tokenListIt != m_tokenList.end()
       && (m_tokenListIt->m_tokenType == END_LINE
-          || trim(m_tokenListIt->m_tokenString).empty())) {
+          || m_tokenListIt->m_tokenString.find_first_not_of(" \t") == string::npos)) {
 
     m_tokenListIt++;
   }
@@ -255,11 +312,9 @@ std::string DoxygenParser::getStringTilCommand(const TokenList & tokList)
 
   string description;
 
-  while (m_tokenListIt->m_tokenType == PLAINSTRING) {
-    const Token &currentToken = *m_tokenListIt++;
-    if (currentToken.m_tokenType == PLAINSTRING) {
-      description = description + currentToken.m_tokenString; // + " ";
-    }
+  while (m_tokenListIt != tokList.end()
+      && m_tokenListIt->m_tokenType == PLAINSTRING) {
+    description += (m_tokenListIt++)->m_tokenString; // + " ";
   }
   return description;
 }
@@ -905,8 +960,12 @@ int DoxygenParser::addCommand(const std::string &commandString,
                               const TokenList &tokList,
                               DoxygenEntityList &doxyList)
 {
- 
-  string theCommand = stringToLower(commandString);
+  // commands are tokenized in lower case, except HTML tags
+  for (size_t i = 0; i < commandString.size(); i++) {
+    if (isupper((unsigned char)commandString[i]))
+      return addCommand(stringToLower(commandString), tokList, doxyList);
+  }
+  const string &theCommand = commandString;
 
   if (theCommand == "plainstd::string") {
     string nextPhrase = getStringTilCommand(tokList);
@@ -960,7 +1019,7 @@ DoxygenEntityList DoxygenParser::parse(TokenListCIt endParsingIndex,
 
   while (m_tokenListIt != endParsingIndex) {
 
-    Token currToken = *m_tokenListIt;
+    const Token &currToken = *m_tokenListIt;
 
     if (noisy)
       cout << "Parsing for phrase starting in:" << currToken.toString() << endl;
@@ -989,6 +1048,18 @@ DoxygenEntityList DoxygenParser::createTree(const std::string &doxygenBlob,
                                             const std::string &fileName,
                                             int lineNumber)
 {
+  // the key includes the location, so that warnings are the same as when
+  // the comment was parsed first
+  char lineStr[32];
+  sprintf(lineStr, ":%d\n", lineNumber);
+  std::string key = fileName + lineStr + doxygenBlob;
+
+  if (!noisy) {
+    DoxygenTreeCache::const_iterator it = m_treeCache.find(key);
+    if (it != m_treeCache.end()) {
+      return it->second;
+    }
+  }
 
   tokenizeDoxygenComment(doxygenBlob, fileName, lineNumber);
   if (noisy) {
@@ -1002,28 +1073,10 @@ DoxygenEntityList DoxygenParser::createTree(const std::string &doxygenBlob,
     cout << "PARSED LIST" << endl;
     printTree(rootList);
   }
+  m_treeCache[key] = rootList;
   return rootList;
 }
 
-/*
- * Splits 'text' on 'separator' chars. Separator chars are not part of the
- * strings.
- */
-DoxygenParser::StringVector DoxygenParser::split(const std::string &text,
-                                                 char separator)
-{
-  StringVector lines;
-  size_t prevPos = 0, pos = 0;
-
-  while (pos < string::npos) {
-    pos = text.find(separator, prevPos);
-    lines.push_back(text.substr(prevPos, pos - prevPos));
-    prevPos = pos + 1;
-  }
-
-  return lines;
-}
-
 /*
  * Returns true, if 'c' is one of doxygen comment block start
  * characters: *, /, or !
@@ -1107,7 +1160,7 @@ bool DoxygenParser::processEscapedChars(size_t &pos, const std::string &line)
   if ((pos + 1) < line.size()) {
 
     // \ and @ with trailing whitespace or quoted get to output as plain string
-    string whitespaces = " '\t\n";
+    static const string whitespaces = " '\t\n";
     if (whitespaces.find(line[pos + 1]) != string::npos) {
       m_tokenList.push_back(Token(PLAINSTRING, line.substr(pos, 1)));
       pos++;
@@ -1115,7 +1168,7 @@ bool DoxygenParser::processEscapedChars(size_t &pos, const std::string &line)
     }
 
     // these chars can be escaped for doxygen
-    string escapedChars = "$@\\&~<>#%\".";
+    static const string escapedChars = "$@\\&~<>#%\".";
     if (escapedChars.find(line[pos + 1]) != string::npos) {
 
       addDoxyCommand(m_tokenList, line.substr(pos + 1, 1));
@@ -1306,117 +1359,137 @@ void DoxygenParser::tokenizeDoxygenComment(const std::string &doxygenComment,
   m_fileLineNo = fileLine;
   m_fileName = fileName;
 
-  StringVector lines = split(doxygenComment, '\n');
+  size_t endPos = doxygenComment.size();
 
   // remove trailing spaces, because they cause additional new line at the end
   // comment, which is wrong, because these spaces are space preceding
   // end of comment :  '  */'
-  if (!doxygenComment.empty() && doxygenComment[doxygenComment.size() - 1] == ' ') {
-
-    string lastLine = lines[lines.size() - 1];
+  if (endPos && doxygenComment[endPos - 1] == ' ') {
+    size_t lastLinePos = doxygenComment.rfind('\n');
+    size_t lastLineStart = (lastLinePos == string::npos) ? 0 : lastLinePos + 1;
+
+    if (doxygenComment.find_first_not_of(" \t", lastLineStart) == string::npos) {
+      if (lastLinePos == string::npos) {  // the only line is empty
+        m_tokenListIt = m_tokenList.begin();
+        return;
+      }
+      endPos = lastLinePos;  // remove trailing empty line
+    }
+  }
 
-    if (trim(lastLine).empty()) {
-      lines.pop_back(); // remove trailing empy line
+  // the lines are tokenized one at a time from the comment, reusing the
+  // same buffer
+  string line;
+  size_t lineStart = 0;
+  while (true) {
+    size_t lineEnd = doxygenComment.find('\n', lineStart);
+    if (lineEnd == string::npos || lineEnd > endPos) {
+      lineEnd = endPos;
     }
+    line.assign(doxygenComment, lineStart, lineEnd - lineStart);
+    tokenizeLine(line);
+    if (lineEnd == endPos) {
+      break;
+    }
+    lineStart = lineEnd + 1;
   }
 
-  for (StringVectorCIt it = lines.begin(); it != lines.end(); it++) {
-    const string &line = *it;
-    size_t pos = line.find_first_not_of(" \t");
+  m_tokenListIt = m_tokenList.begin();
+}
 
-    if (pos == string::npos) {
-      m_tokenList.push_back(Token(END_LINE, "\n"));
-      continue;
-    }
+void DoxygenParser::tokenizeLine(const std::string &line)
+{
+  size_t pos = line.find_first_not_of(" \t");
 
-    // skip sequences of '*', '/', and '!' of any length
-    bool isStartOfCommentLineCharFound = false;
-    while (pos < line.size() && isStartOfDoxyCommentChar(line[pos])) {
-      pos++;
-      isStartOfCommentLineCharFound = true;
-    }
+  if (pos == string::npos) {
+    m_tokenList.push_back(Token(END_LINE, "\n"));
+    return;
+  }
 
-    if (pos == line.size()) {
-      m_tokenList.push_back(Token(END_LINE, "\n"));
-      continue;
-    }
+  // skip sequences of '*', '/', and '!' of any length
+  bool isStartOfCommentLineCharFound = false;
+  while (pos < line.size() && isStartOfDoxyCommentChar(line[pos])) {
+    pos++;
+    isStartOfCommentLineCharFound = true;
+  }
 
-    // if 'isStartOfCommentLineCharFound' then preserve leading spaces, so
-    // ' *    comment' gets translated to ' *    comment', not ' * comment'
-    // This is important to keep formatting for comments translated to Python.
-    if (isStartOfCommentLineCharFound && line[pos] == ' ') {
-      pos++; // points to char after ' * '
-      if (pos == line.size()) {
-        m_tokenList.push_back(Token(END_LINE, "\n"));
-        continue;
-      }
-    }
+  if (pos == line.size()) {
+    m_tokenList.push_back(Token(END_LINE, "\n"));
+    return;
+  }
 
-    // line[pos] may be ' \t' or start of word, it there was no '*', '/' or '!'
-    // at beginning of the line. Make sure it points to start of the first word
-    // in the line.
-    size_t firstWordPos = line.find_first_not_of(" \t", pos);
-    if (firstWordPos == string::npos) {
+  // if 'isStartOfCommentLineCharFound' then preserve leading spaces, so
+  // ' *    comment' gets translated to ' *    comment', not ' * comment'
+  // This is important to keep formatting for comments translated to Python.
+  if (isStartOfCommentLineCharFound && line[pos] == ' ') {
+    pos++; // points to char after ' * '
+    if (pos == line.size()) {
       m_tokenList.push_back(Token(END_LINE, "\n"));
-      continue;
+      return;
     }
+  }
 
-    if (isStartOfCommentLineCharFound && firstWordPos > pos) {
-      m_tokenList.push_back(
-          Token(PLAINSTRING, line.substr(pos, firstWordPos - pos)));
-    }
+  // line[pos] may be ' \t' or start of word, it there was no '*', '/' or '!'
+  // at beginning of the line. Make sure it points to start of the first word
+  // in the line.
+  size_t firstWordPos = line.find_first_not_of(" \t", pos);
+  if (firstWordPos == string::npos) {
+    m_tokenList.push_back(Token(END_LINE, "\n"));
+    return;
+  }
 
-    pos = firstWordPos;
-
-    while (pos != string::npos) {
-      // find the end of the word
-      size_t doxyCmdOrHtmlTagPos = line.find_first_of("\\@<>&\" \t", pos);
-      if (doxyCmdOrHtmlTagPos != pos) {
-        // plain text found
-        // if the last char is punctuation, make it a separate word, otherwise
-        // it may be included with word also when not appropriate, for example:
-        //   colors are \b red, green, and blue --> colors are <b>red,</b> green, and blue
-        // instead of (comma not bold):
-        //   colors are \b red, green, and blue --> colors are <b>red</b>, green, and blue
-        // In Python it looks even worse:
-        //   colors are \b red, green, and blue --> colors are 'red,' green, and blue
-        string text = line.substr(pos, doxyCmdOrHtmlTagPos - pos);
-        string punctuations(".,:");
-        size_t textSize = text.size();
-
-        if (!text.empty()
-            && punctuations.find(text[text.size() - 1]) != string::npos &&
-            // but do not break ellipsis (...)
-            !(textSize > 1 && text[textSize - 2] == '.')) {
-          m_tokenList.push_back(Token(PLAINSTRING, text.substr(0, text.size() - 1)));
-          m_tokenList.push_back(Token(PLAINSTRING, text.substr(text.size() - 1)));
-        } else {
-          m_tokenList.push_back(Token(PLAINSTRING, text));
-        }
-      }
+  if (isStartOfCommentLineCharFound && firstWordPos > pos) {
+    m_tokenList.push_back(
+        Token(PLAINSTRING, line.substr(pos, firstWordPos - pos)));
+  }
 
-      pos = doxyCmdOrHtmlTagPos;
-      if (pos != string::npos) {
-        if (m_isVerbatimText) {
-          pos = processVerbatimText(pos, line);
+  pos = firstWordPos;
+
+  while (pos != string::npos) {
+    // find the end of the word
+    size_t doxyCmdOrHtmlTagPos = line.find_first_of("\\@<>&\" \t", pos);
+    if (doxyCmdOrHtmlTagPos != pos) {
+      // plain text found
+      // if the last char is punctuation, make it a separate word, otherwise
+      // it may be included with word also when not appropriate, for example:
+      //   colors are \b red, green, and blue --> colors are <b>red,</b> green, and blue
+      // instead of (comma not bold):
+      //   colors are \b red, green, and blue --> colors are <b>red</b>, green, and blue
+      // In Python it looks even worse:
+      //   colors are \b red, green, and blue --> colors are 'red,' green, and blue
+      size_t textEnd = (doxyCmdOrHtmlTagPos == string::npos) ? line.size() : doxyCmdOrHtmlTagPos;
+      size_t textSize = textEnd - pos;
+      char lastChar = textSize ? line[textEnd - 1] : 0;
+
+      if ((lastChar == '.' || lastChar == ',' || lastChar == ':') &&
+          // but do not break ellipsis (...)
+          !(textSize > 1 && line[textEnd - 2] == '.')) {
+        m_tokenList.push_back(Token(PLAINSTRING, line.substr(pos, textSize - 1)));
+        m_tokenList.push_back(Token(PLAINSTRING, line.substr(textEnd - 1, 1)));
+      } else {
+        m_tokenList.push_back(Token(PLAINSTRING, line.substr(pos, textSize)));
+      }
+    }
 
-        } else if (m_isInQuotedString) {
+    pos = doxyCmdOrHtmlTagPos;
+    if (pos != string::npos) {
+      if (m_isVerbatimText) {
+        pos = processVerbatimText(pos, line);
 
-          if (line[pos] == '"') {
-            m_isInQuotedString = false;
-          }
-          m_tokenList.push_back(Token(PLAINSTRING, line.substr(pos, 1)));
-          pos++;
+      } else if (m_isInQuotedString) {
 
-        } else {
-          pos = processNormalComment(pos, line);
+        if (line[pos] == '"') {
+          m_isInQuotedString = false;
         }
+        m_tokenList.push_back(Token(PLAINSTRING, line.substr(pos, 1)));
+        pos++;
+
+      } else {
+        pos = processNormalComment(pos, line);
       }
     }
-    m_tokenList.push_back(Token(END_LINE, "\n")); // add when pos == npos - end of line
   }
-
-  m_tokenListIt = m_tokenList.begin();
+  m_tokenList.push_back(Token(END_LINE, "\n")); // add when pos == npos - end of line
 }
 
 void DoxygenParser::printList()
@@ -15,7 +15,6 @@
 #include <list>
 #include <map>
 #include <vector>
-#include <set>
 #include "DoxygenEntity.h"
 
 class DoxygenParser {
@@ -48,7 +47,7 @@ private:
     DoxyCommandEnum m_tokenType;
     std::string m_tokenString;		/* the data , such as param for @param */
 
-    Token(DoxyCommandEnum tType, std::string tString) :
+    Token(DoxyCommandEnum tType, const std::string &tString) :
       m_tokenType(tType),
       m_tokenString(tString) {}
 
@@ -77,15 +76,37 @@ private:
   TokenList m_tokenList;
   TokenListCIt m_tokenListIt;
 
-  typedef std::map<std::string, DoxyCommandEnum> DoxyCommandsMap;
-  typedef DoxyCommandsMap::iterator DoxyCommandsMapIt;
+  /*
+   * Entry in the table of Doxygen commands, which determines if a string is
+   * a command, how it needs to be parsed and if it starts a new section.
+   */
+  struct DoxyCommand {
+    const char *name;
+    size_t len;
+    int commandType;           /* -1 if the name is only a section indicator */
+    bool isSectionIndicator;
+  };
+
+  /*
+   * Open addressing hash table of Doxygen commands, filled once from
+   * DoxygenCommands.h. Lookups are case insensitive and allocate nothing.
+   */
+  enum { DOXY_COMMANDS_TABLE_SIZE = 1024 };
+  static DoxyCommand doxygenCommands[DOXY_COMMANDS_TABLE_SIZE];
+  static bool doxygenCommandsFilled;
+
+  static size_t hashCommand(const char *name, size_t len);
+  static DoxyCommand *lookupCommand(const char *name, size_t len, bool insert = false);
+  static void addCommandToTable(const char *name, int commandType);
 
   /*
-   * Map of Doxygen commands to determine if a string is a
-   * command and how it needs to be parsed
+   * Parse trees of the comments already seen, keyed by file, line and
+   * comment text. The same comment is parsed repeatedly for overloads,
+   * template instantiations and when more than one docstring is made for
+   * a node.
    */
-  static DoxyCommandsMap doxygenCommands;
-  static std::set<std::string> doxygenSectionIndicators;
+  typedef std::map<std::string, DoxygenEntityList> DoxygenTreeCache;
+  DoxygenTreeCache m_treeCache;
 
   bool m_isVerbatimText; // used to handle \htmlonly and \verbatim commands
   bool m_isInQuotedString;
@@ -363,16 +384,15 @@ private:
   /** Processes comment outside \htmlonly and \verbatim commands. */
   size_t processNormalComment(size_t pos, const std::string &line);
 
+  /** Tokenizes one line of the comment. */
+  void tokenizeLine(const std::string &line);
+
   void tokenizeDoxygenComment(const std::string &doxygenComment,
                                  const std::string &fileName,
                                  int fileLine);
   void printList();
   void printListError(int warningType, const std::string &message);
 
-  typedef std::vector<std::string> StringVector;
-  typedef StringVector::const_iterator StringVectorCIt;
-
-  StringVector split(const std::string &text, char separator);
   bool isStartOfDoxyCommentChar(char c);
   bool addDoxyCommand(DoxygenParser::TokenList &tokList, const std::string &cmd);
 
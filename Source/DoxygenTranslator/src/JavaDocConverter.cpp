@@ -348,9 +348,8 @@ bool JavaDocConverter::paramExists(std::string param)
     return true;
   }
 
-  ParmList *plist = CopyParmList(Getattr(currentNode, "parms"));
-
-  for (Parm *p = plist; p;) {
+  // the parameters are only looked at, so they need not be copied
+  for (Parm *p = Getattr(currentNode, "parms"); p;) {
 
     if (Getattr(p, "name") && Char (Getattr(p, "name")) == param) {
       return true;
@@ -362,8 +361,6 @@ bool JavaDocConverter::paramExists(std::string param)
     p = nextSibling(p);
   }
 
-  Delete(plist);
-
   return false;
 }
 
@@ -236,11 +236,13 @@ PyDocConverter::PyDocConverter(bool debugTranslator, bool debugParser) :
 
 std::string PyDocConverter::getParamType(std::string param)
 {
-  ParmList *plist = CopyParmList(Getattr(currentNode, "parms"));
-  Parm *p = NULL;
-  for (p = plist; p;) {
-    if (Char (Getattr(p, "name")) == param) {
-      std::string type = Char (SwigType_str(Getattr(p, "type"), ""));
+  // the parameters are only looked at, so they need not be copied
+  for (Parm *p = Getattr(currentNode, "parms"); p;) {
+    String *name = Getattr(p, "name");
+    if (name && Char (name) == param) {
+      String *typeStr = SwigType_str(Getattr(p, "type"), "");
+      std::string type = Char (typeStr);
+      Delete(typeStr);
       return type;
     }
     /*
@@ -250,7 +252,6 @@ std::string PyDocConverter::getParamType(std::string param)
     //p = Getattr(p, "tmap:in") ? Getattr(p, "tmap:in:next") : nextSibling(p);
     p = nextSibling(p);
   }
-  Delete(plist);
   return "";
 }
 
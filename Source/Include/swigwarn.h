@@ -296,6 +296,7 @@
 /* please leave 870-889 free for PHP */
 
 #define WARN_GO_NAME_CONFLICT                 890
+#define WARN_GO_BATCH                         891
 
 /* please leave 890-899 free for Go */
 
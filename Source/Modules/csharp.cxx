@@ -765,12 +765,20 @@ public:
     int num_arguments = 0;
     bool is_void_return;
     String *overloaded_name = getOverloadedName(n);
+    bool blittable = GetFlag(n, "feature:csblittable") ? true : false;
+    // An empty exception specification, ie throw(), means the pending exception check is not needed
+    bool nothrow = blittable && Getattr(n, "throw") && !Getattr(n, "throws");
 
     if (!Getattr(n, "sym:overloaded")) {
       if (!addSymbol(Getattr(n, "sym:name"), n, imclass_name))
 	return SWIG_ERROR;
     }
 
+    // Pointers are passed as IntPtr instead of HandleRef in blittable mode. Not done for variable
+    // wrappers as the C# properties have no finally block to keep the proxy class alive in.
+    if (blittable && !global_variable_flag && !wrapping_member_flag)
+      Setattr(n, "csharp:blittable", "1");
+
     /*
        The rest of this function deals with generating the intermediary class wrapper function (that wraps
        a c/c++ function) and generating the PInvoke c code. Each C# wrapper function has a 
@@ -833,7 +841,10 @@ public:
       }
     }
 
-    Printv(imclass_class_code, "\n  [DllImport(\"", dllimport, "\", EntryPoint=\"", wname, "\")]\n", NIL);
+    Printf(imclass_class_code, "\n");
+    if (blittable)
+      Printf(imclass_class_code, "  [System.Security.SuppressUnmanagedCodeSecurity]\n");
+    Printv(imclass_class_code, "  [DllImport(\"", dllimport, "\", EntryPoint=\"", wname, "\")]\n", NIL);
 
     if (im_outattributes)
       Printf(imclass_class_code, "  %s\n", im_outattributes);
@@ -870,7 +881,10 @@ public:
       /* Get the intermediary class parameter types of the parameter */
       if ((tm = Getattr(p, "tmap:imtype"))) {
 	const String *inattributes = Getattr(p, "tmap:imtype:inattributes");
-	Printf(im_param_type, "%s%s", inattributes ? inattributes : empty_string, tm);
+	if (isBlittableHandle(n, p))
+	  Printf(im_param_type, "%sIntPtr", inattributes ? inattributes : empty_string);
+	else
+	  Printf(im_param_type, "%s%s", inattributes ? inattributes : empty_string, tm);
       } else {
 	Swig_warning(WARN_CSHARP_TYPEMAP_CSTYPE_UNDEF, input_file, line_number, "No imtype typemap defined for %s\n", SwigType_str(pt, 0));
       }
@@ -1054,14 +1068,14 @@ public:
       Wrapper_print(f, f_wrappers);
 
       // Handle %csexception which sets the canthrow attribute
-      if (Getattr(n, "feature:except:canthrow"))
+      if (Getattr(n, "feature:except:canthrow") && !nothrow)
 	Setattr(n, "csharp:canthrow", "1");
 
       // A very simple check (it is not foolproof) to help typemap/feature writers for
       // throwing C# exceptions from unmanaged code. It checks for the common methods which
       // set a pending C# exception... the 'canthrow' typemap/feature attribute must be set
       // so that code which checks for pending exceptions is added in the C# proxy method.
-      if (!Getattr(n, "csharp:canthrow")) {
+      if (!Getattr(n, "csharp:canthrow") && !nothrow) {
 	if (Strstr(f->code, "SWIG_exception")) {
 	  Swig_warning(WARN_CSHARP_CANTHROW, input_file, line_number,
 		       "Unmanaged code contains a call to SWIG_exception and C# code does not handle pending exceptions via the canthrow attribute.\n");
@@ -2270,6 +2284,8 @@ public:
     Swig_typemap_attach_parms("in", l, NULL);
     Swig_typemap_attach_parms("cstype", l, NULL);
     Swig_typemap_attach_parms("csin", l, NULL);
+    if (Getattr(n, "csharp:blittable"))
+      Swig_typemap_attach_parms("imtype", l, NULL);
 
     /* Get return types */
     if ((tm = Swig_typemap_lookup("cstype", n, "", 0))) {
@@ -2333,8 +2349,13 @@ public:
     Printf(function_code, "%s %s(", return_type, proxy_function_name);
 
     Printv(imcall, full_imclass_name, ".$imfuncname(", NIL);
-    if (!static_flag)
+    if (!static_flag) {
       Printf(imcall, "swigCPtr");
+      if (Getattr(n, "csharp:blittable")) {
+	Printf(imcall, ".Handle");
+	Printf(post_code, "      GC.KeepAlive(this);");
+      }
+    }
 
     emit_mark_varargs(l);
 
@@ -2404,6 +2425,8 @@ public:
               Insert(terminator_code, 0, "\n");
             Insert(terminator_code, 0, terminator);
           }
+	  if (isBlittableHandle(n, p))
+	    blittableHandleSubstitute(tm, arg, post_code);
 	  Printv(imcall, tm, NIL);
 	} else {
 	  Swig_warning(WARN_CSHARP_TYPEMAP_CSIN_UNDEF, input_file, line_number, "No csin typemap defined for %s\n", SwigType_str(pt, 0));
@@ -2645,6 +2668,8 @@ public:
       Swig_typemap_attach_parms("in", l, NULL);
       Swig_typemap_attach_parms("cstype", l, NULL);
       Swig_typemap_attach_parms("csin", l, NULL);
+      if (Getattr(n, "csharp:blittable"))
+	Swig_typemap_attach_parms("imtype", l, NULL);
 
       emit_mark_varargs(l);
 
@@ -2714,6 +2739,8 @@ public:
           cshin = Getattr(p, "tmap:csin:cshin");
           if (cshin)
             Replaceall(cshin, "$csinput", arg);
+	  if (isBlittableHandle(n, p))
+	    blittableHandleSubstitute(tm, arg, post_code);
 	  Printv(imcall, tm, NIL);
 	} else {
 	  Swig_warning(WARN_CSHARP_TYPEMAP_CSIN_UNDEF, input_file, line_number, "No csin typemap defined for %s\n", SwigType_str(pt, 0));
@@ -2820,7 +2847,7 @@ public:
     String *symname = Getattr(n, "sym:name");
 
     if (proxy_flag) {
-      Printv(destructor_call, full_imclass_name, ".", Swig_name_destroy(getNSpace(), symname), "(swigCPtr)", NIL);
+      Printv(destructor_call, full_imclass_name, ".", Swig_name_destroy(getNSpace(), symname), Getattr(n, "csharp:blittable") ? "(swigCPtr.Handle)" : "(swigCPtr)", NIL);
     }
     return SWIG_OK;
   }
@@ -3039,6 +3066,8 @@ public:
             Insert(terminator_code, 0, "\n");
           Insert(terminator_code, 0, terminator);
         }
+	if (isBlittableHandle(n, p))
+	  blittableHandleSubstitute(tm, arg, post_code);
 	Printv(imcall, tm, NIL);
       } else {
 	Swig_warning(WARN_CSHARP_TYPEMAP_CSIN_UNDEF, input_file, line_number, "No csin typemap defined for %s\n", SwigType_str(pt, 0));
@@ -3492,6 +3521,31 @@ public:
     Delete(canthrow_attribute);
   }
 
+  /* -----------------------------------------------------------------------------
+   * isBlittableHandle()
+   * Determine whether a HandleRef parameter is passed as an IntPtr as the
+   * csblittable feature is in use for the method.
+   * ----------------------------------------------------------------------------- */
+
+  bool isBlittableHandle(Node *n, Parm *p) {
+    return Getattr(n, "csharp:blittable") && Cmp(Getattr(p, "tmap:imtype"), "HandleRef") == 0;
+  }
+
+  /* -----------------------------------------------------------------------------
+   * blittableHandleSubstitute()
+   * Passes the IntPtr from the HandleRef in the csin typemap code instead of the
+   * HandleRef itself. The C# object is kept alive until the call returns, which
+   * is what the HandleRef marshalling otherwise ensures.
+   * ----------------------------------------------------------------------------- */
+
+  void blittableHandleSubstitute(String *code, const String *csinput, String *post_code) {
+    Insert(code, 0, "(");
+    Printf(code, ").Handle");
+    if (Len(post_code) > 0)
+      Printf(post_code, "\n");
+    Printf(post_code, "      GC.KeepAlive(%s);", csinput);
+  }
+
   /* -----------------------------------------------------------------------------
    * excodeSubstitute()
    * If a method can throw a C# exception, additional exception code is added to
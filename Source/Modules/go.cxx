@@ -660,6 +660,19 @@ private:
       return r;
     }
 
+    if (GetFlag(n, "feature:go:batch")) {
+      if (making_variable_wrappers || is_ctor_dtor || overname) {
+	Swig_warning(WARN_GO_BATCH, input_file, line_number,
+		     "Batch wrapper for '%s' not generated: not supported for constructors, destructors, variables or overloaded functions\n",
+		     name);
+      } else {
+	r = makeBatchWrappers(n, name, go_name, wname, parms, result, is_static);
+	if (r != SWIG_OK) {
+	  return r;
+	}
+      }
+    }
+
     if (Getattr(n, "sym:overloaded") && !Getattr(n, "sym:nextSibling")) {
       String *scope ;
       if (!class_name || is_static || is_ctor_dtor) {
@@ -757,6 +770,308 @@ private:
     return SWIG_OK;
   }
 
+  /* ----------------------------------------------------------------------
+   * makeBatchWrappers()
+   *
+   * Write out the wrappers for the go:batch feature.  The Go function
+   * takes a slice of structs holding the arguments of each call and a
+   * slice for the results, and the C/C++ function loops over the
+   * slices, so that there is a single call from Go into C/C++ for all
+   * of the calls.  The structs are laid out the same way in Go and
+   * C/C++, so only parameters and results with a simple numeric Go
+   * type are supported.  The receiver of a method is passed as a
+   * uintptr, the value returned by the Swigcptr method.
+   * ---------------------------------------------------------------------- */
+
+  int makeBatchWrappers(Node *n, String *name, String *go_name, String *wname, ParmList *parms, SwigType *result, bool is_static) {
+    bool has_receiver = class_receiver && !is_static;
+
+    if (has_receiver && Swig_directorclass(n)) {
+      Swig_warning(WARN_GO_BATCH, input_file, line_number, "Batch wrapper for '%s' not generated: not supported for director classes\n", name);
+      return SWIG_OK;
+    }
+
+    Wrapper *f = NewWrapper();
+
+    Swig_save("makeBatchWrappers", n, "parms", NULL);
+
+    emit_parameter_variables(parms, f);
+    emit_attach_parmmaps(parms, f);
+    Swig_typemap_attach_parms("gotype", parms, f);
+    int parm_count = emit_num_arguments(parms);
+    int required_count = emit_num_required(parms);
+
+    bool is_void = SwigType_type(result) == T_VOID;
+
+    // Check that the parameters and result can be represented in a struct.
+    bool ok = parm_count == required_count && (is_void || batchTypeOk(n, result));
+    Parm *p = parms;
+    for (int i = 0; ok && i < parm_count; ++i) {
+      p = getParm(p);
+      if (i > 0 || !has_receiver) {
+	ok = batchTypeOk(p, Getattr(p, "type"));
+      }
+      p = nextParm(p);
+    }
+    if (!ok) {
+      Swig_warning(WARN_GO_BATCH, input_file, line_number,
+		   "Batch wrapper for '%s' not generated: the parameters and result must have numeric or bool Go types, without default values\n", name);
+      Swig_restore(n);
+      DelWrapper(f);
+      return SWIG_OK;
+    }
+
+    String *batch_name = NewString("");
+    if (has_receiver) {
+      String *cn = exportedName(class_name);
+      Append(batch_name, cn);
+      Delete(cn);
+    }
+    Printv(batch_name, go_name, "Batch", NULL);
+    String *args_name = NewStringf("%sArgs", batch_name);
+
+    if (!checkNameConflict(batch_name, n, NULL) || !checkNameConflict(args_name, n, NULL)) {
+      Swig_restore(n);
+      DelWrapper(f);
+      Delete(batch_name);
+      Delete(args_name);
+      return SWIG_OK;
+    }
+
+    String *batch_wname = NewStringf("%s_batch", wname);
+    String *wrapper_name = buildGoWrapperName(name, NULL);
+    Append(wrapper_name, "_batch");
+    String *result_type = is_void ? NULL : goType(n, result);
+
+    // The Go struct and the C struct holding the arguments of a call.
+
+    String *cstruct = NewString("\tstruct swigbatchargs {\n");
+    Printv(f_go_wrappers, "type ", args_name, " struct {\n", NULL);
+    // Parameter names may clash with Self or with each other once
+    // exported, e.g. "x" and "X", so fall back to ArgN, then ArgN_M.
+    Hash *fields = NewHash();
+    p = parms;
+    for (int i = 0; i < parm_count; ++i) {
+      p = getParm(p);
+      String *field;
+      if (i == 0 && has_receiver) {
+	field = NewString("Self");
+      } else {
+	String *pn = Getattr(p, "name");
+	String *fn = pn ? Copy(pn) : NewStringf("arg%d", i + 1);
+	field = exportedName(fn);
+	Delete(fn);
+	if (Getattr(fields, field)) {
+	  Delete(field);
+	  field = NewStringf("Arg%d", i + 1);
+	  for (int j = 2; Getattr(fields, field); ++j) {
+	    Delete(field);
+	    field = NewStringf("Arg%d_%d", i + 1, j);
+	  }
+	}
+      }
+      Setattr(fields, field, p);
+      Setattr(p, "go:batchfield", field);
+      String *gt = (i == 0 && has_receiver) ? NewString("uintptr") : goType(p, Getattr(p, "type"));
+      Printv(f_go_wrappers, "\t", field, " ", gt, "\n", NULL);
+      String *ct = gcCTypeForGoValue(p, Getattr(p, "type"), field);
+      Printv(cstruct, "\t\t", ct, ";\n", NULL);
+      Delete(ct);
+      Delete(gt);
+      Delete(field);
+      p = nextParm(p);
+    }
+    Delete(fields);
+    Printv(f_go_wrappers, "}\n\n", NULL);
+    Printv(cstruct, "\t} *swig_b = (struct swigbatchargs *) swig_args.array;\n", NULL);
+
+    // The Go declaration of the C function and the exported Go function.
+
+    if (gccgo_flag) {
+      Printv(f_go_wrappers, "//extern ", go_prefix, "_", batch_wname, "\n", NULL);
+    }
+    Printv(f_go_wrappers, "func ", wrapper_name, "([]", args_name, NULL);
+    if (!is_void) {
+      Printv(f_go_wrappers, ", []", result_type, NULL);
+    }
+    Printv(f_go_wrappers, ")\n\n", NULL);
+
+    Printv(f_go_wrappers, "func ", batch_name, "(args []", args_name, NULL);
+    if (!is_void) {
+      Printv(f_go_wrappers, ", results []", result_type, ") {\n", NULL);
+      Printv(f_go_wrappers, "\tif len(results) < len(args) {\n", NULL);
+      Printv(f_go_wrappers, "\t\tpanic(\"", batch_name, ": results is shorter than args\")\n", NULL);
+      Printv(f_go_wrappers, "\t}\n", NULL);
+    } else {
+      Printv(f_go_wrappers, ") {\n", NULL);
+    }
+    if (gccgo_flag) {
+      Printv(f_go_wrappers, "\tdefer SwigCgocallDone()\n", NULL);
+      Printv(f_go_wrappers, "\tSwigCgocall()\n", NULL);
+    }
+    Printv(f_go_wrappers, "\t", wrapper_name, "(args", is_void ? "" : ", results", ")\n", NULL);
+    Printv(f_go_wrappers, "}\n\n", NULL);
+
+    // The 6c/8c function which calls the C function.
+
+    if (!gccgo_flag) {
+      Wrapper *gc = NewWrapper();
+      Printv(gc->def, "#pragma dynimport ", batch_wname, " ", batch_wname, " \"\"\n", NULL);
+      Printv(gc->def, "extern void (*", batch_wname, ")(void*);\n", NULL);
+      Printv(gc->def, "static void (*x", batch_wname, ")(void*) = ", batch_wname, ";\n", NULL);
+      Printv(gc->def, "\n", NULL);
+      Printv(gc->def, "void\n", NULL);
+      Printv(gc->def, "\xc2\xb7", wrapper_name, "(struct { uint8 x[(3 * SWIG_PARM_SIZE)", is_void ? "" : " + (3 * SWIG_PARM_SIZE)", "];} p)", NULL);
+      Printv(gc->code, "{\n", NULL);
+      Printv(gc->code, "\truntime\xc2\xb7" "cgocall(x", batch_wname, ", &p);\n", NULL);
+      Printv(gc->code, "}\n", NULL);
+      Printv(gc->code, "\n", NULL);
+      Wrapper_print(gc, f_gc_wrappers);
+      DelWrapper(gc);
+    }
+
+    // The C/C++ function, which makes one call for each element of the
+    // args slice.
+
+    emit_return_variable(n, result, f);
+
+    if (!gccgo_flag) {
+      Printv(f->def, "void\n", batch_wname, "(void *swig_v)\n", "{\n", NULL);
+      Printv(f->code, "\tstruct swigargs {\n", NULL);
+      Printv(f->code, "\t\t_goslice_ args;\n", NULL);
+      if (!is_void) {
+	Printv(f->code, "\t\t_goslice_ results;\n", NULL);
+      }
+      Printv(f->code, "\t} *swig_a = (struct swigargs *) swig_v;\n", NULL);
+      Printv(f->code, "\t_goslice_ swig_args = swig_a->args;\n", NULL);
+      if (!is_void) {
+	Printv(f->code, "\t_goslice_ swig_results = swig_a->results;\n", NULL);
+      }
+    } else {
+      Printv(f->def, "void ", go_prefix, "_", batch_wname, "(_goslice_ swig_args", is_void ? "" : ", _goslice_ swig_results", ") {\n", NULL);
+    }
+
+    Printv(f->code, cstruct, NULL);
+    if (!is_void) {
+      String *rn = NewString("*swig_r");
+      String *ct = gcCTypeForGoValue(n, result, rn);
+      Printv(f->code, "\t", ct, " = (", NULL);
+      Delete(ct);
+      Delete(rn);
+      rn = NewString("*");
+      ct = gcCTypeForGoValue(n, result, rn);
+      Printv(f->code, ct, ") swig_results.array;\n", NULL);
+      Delete(ct);
+      Delete(rn);
+    }
+    Wrapper_add_local(f, "swig_i", "intgo swig_i");
+
+    Printv(f->code, "\n", NULL);
+    Printv(f->code, "\tfor (swig_i = 0; swig_i < swig_args.len; ++swig_i) {\n", NULL);
+
+    p = parms;
+    for (int i = 0; i < parm_count; ++i) {
+      p = getParm(p);
+      String *tm = Getattr(p, "tmap:in");
+      if (!tm) {
+	Swig_warning(WARN_TYPEMAP_IN_UNDEF, input_file, line_number, "Unable to use type %s as a function argument\n", SwigType_str(Getattr(p, "type"), 0));
+      } else {
+	String *input = NewStringf("swig_b[swig_i].%s", Getattr(p, "go:batchfield"));
+	Replaceall(tm, "$input", input);
+	Setattr(p, "emit:input", input);
+	Printv(f->code, "\t\t", tm, "\n", NULL);
+	Delete(input);
+      }
+      p = nextParm(p);
+    }
+
+    checkConstraints(parms, f);
+
+    emitBatchAction(n, result, f);
+
+    argout(parms, f);
+
+    cleanupFunction(n, f, parms);
+
+    Printv(f->code, "\t}\n", NULL);
+    Printv(f->code, "}\n", NULL);
+
+    Wrapper_print(f, f_c_wrappers);
+
+    Swig_restore(n);
+
+    DelWrapper(f);
+    Delete(cstruct);
+    Delete(result_type);
+    Delete(wrapper_name);
+    Delete(batch_wname);
+    Delete(args_name);
+    Delete(batch_name);
+
+    return SWIG_OK;
+  }
+
+  /* ----------------------------------------------------------------------
+   * batchTypeOk()
+   *
+   * Return whether a type can be used in the structs passed to a batch
+   * wrapper: the Go type must be a simple numeric type, bool, or an
+   * enum, which all have the same layout in Go and C/C++.
+   * ---------------------------------------------------------------------- */
+
+  bool batchTypeOk(Node *n, SwigType *type) {
+    static const char *const batch_types[] = {
+      "bool", "int", "uint", "int8", "uint8", "byte", "int16", "uint16", "int32", "uint32",
+      "int64", "uint64", "uintptr", "float32", "float64", NULL
+    };
+    bool is_interface;
+    String *gt = goTypeWithInfo(n, type, &is_interface);
+    bool ok = false;
+    if (!is_interface) {
+      for (int i = 0; batch_types[i] && !ok; ++i) {
+	ok = Strcmp(gt, batch_types[i]) == 0;
+      }
+      if (!ok) {
+	SwigType *t = SwigType_typedef_resolve_all(type);
+	ok = Language::enumLookup(t) != NULL;
+	Delete(t);
+      }
+    }
+    Delete(gt);
+    return ok;
+  }
+
+  /* ----------------------------------------------------------------------
+   * emitBatchAction()
+   *
+   * Emit the action of a function called from a batch wrapper, storing
+   * the result in the results slice.
+   * ---------------------------------------------------------------------- */
+
+  void emitBatchAction(Node *n, SwigType *result, Wrapper *f) {
+    String *actioncode = emit_action(n);
+
+    Swig_save("emitBatchAction", n, "type", "tmap:out", NULL);
+
+    Setattr(n, "type", result);
+
+    String *tm = Swig_typemap_lookup_out("out", n, Swig_cresult_name(), f, actioncode);
+    if (!tm) {
+      Swig_warning(WARN_TYPEMAP_OUT_UNDEF, input_file, line_number, "Unable to use return type %s\n", SwigType_str(result, 0));
+    } else {
+      Replaceall(tm, "$result", "swig_r[swig_i]");
+      if (GetFlag(n, "feature:new")) {
+	Replaceall(tm, "$owner", "1");
+      } else {
+	Replaceall(tm, "$owner", "0");
+      }
+      Printv(f->code, tm, "\n", NULL);
+      Delete(tm);
+    }
+
+    Swig_restore(n);
+  }
+
   /* ----------------------------------------------------------------------
    * goFunctionWrapper()
    *
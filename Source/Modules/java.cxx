@@ -1029,6 +1029,7 @@ public:
     Delete(nondir_args);
 
     /* Insert constraint checking code */
+    String *preaction = NewString("");
     for (p = l; p;) {
       if ((tm = Getattr(p, "tmap:check"))) {
 	addThrows(n, "tmap:check", p);
@@ -1036,6 +1037,10 @@ public:
 	Replaceall(tm, "$arg", Getattr(p, "emit:input"));	/* deprecated? */
 	Replaceall(tm, "$input", Getattr(p, "emit:input"));
 	Printv(f->code, tm, "\n", NIL);
+	// Code for just before the function call, inside the try block of any exception specification handlers
+	String *pre = Getattr(p, "tmap:check:preaction");
+	if (pre && !Strstr(preaction, pre))
+	  Printv(preaction, pre, "\n", NIL);
 	p = Getattr(p, "tmap:check:next");
       } else {
 	p = nextSibling(p);
@@ -1095,6 +1100,8 @@ public:
 
       // Now write code to make the function call
       Swig_director_emit_dynamic_cast(n, f);
+      if (Len(preaction))
+	Setattr(n, "wrap:preaction", preaction);
       String *actioncode = emit_action(n);
 
       // Handle exception classes specified in the "except" feature's "throws" attribute
@@ -1206,6 +1213,7 @@ public:
 
     Delete(c_return_type);
     Delete(im_return_type);
+    Delete(preaction);
     Delete(cleanup);
     Delete(outarg);
     Delete(body);
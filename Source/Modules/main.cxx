@@ -59,10 +59,13 @@ static const char *usage1 = (const char *) "\
      -addextern      - Add extra extern declarations\n\
      -c++            - Enable C++ processing\n\
      -co <file>      - Check <file> out of the SWIG library\n\
+     -compacttypes   - Emit the runtime type table as compact data with few relocations\n\
      -copyctor       - Automatically generate copy constructors wherever possible\n\
      -cpperraswarn   - Treat the preprocessor #error statement as #warning (default)\n\
      -copyright      - Display copyright notices\n\
      -debug-classes  - Display information about the classes found in the interface\n\
+     -debug-include  - Display the include guards found and the includes skipped because of them\n\
+     -debug-lookup   - Display statistics of the %feature and %rename lookup caches\n\
      -debug-module <n>- Display module parse tree at stages 1-4, <n> is a csv list of stages\n\
      -debug-symtabs  - Display symbol tables information\n\
      -debug-symbols  - Display target language symbols in the symbol tables\n\
@@ -121,6 +124,7 @@ static const char *usage2 = (const char *) "\
 
 static const char *usage3 = (const char *) "\
      -notemplatereduce - Disable reduction of the typedefs in templates\n\
+     -notreedispatch - Disable tree dispatch mode (default)\n\
      -O              - Enable the optimization options: \n\
                         -fastdispatch -fvirtual \n\
      -o <outfile>    - Set name of the output file to <outfile>\n\
@@ -131,6 +135,7 @@ static const char *usage3 = (const char *) "\
      -small          - Compile in virtual elimination & compact mode\n\
      -swiglib        - Report location of SWIG library and exit\n\
      -templatereduce - Reduce all the typedefs in templates\n\
+     -treedispatch   - Enable tree dispatch mode, to run each overload typecheck once\n\
      -v              - Run in verbose mode\n\
      -version        - Display SWIG version number\n\
      -Wall           - Remove all warning suppression, also implies -Wextra\n\
@@ -182,6 +187,8 @@ static int dump_xml = 0;
 static int browse = 0;
 static int dump_typedef = 0;
 static int dump_classes = 0;
+static int dump_include = 0;
+static int dump_lookup = 0;
 static int werror = 0;
 static int depend = 0;
 static int depend_only = 0;
@@ -493,6 +500,12 @@ void SWIG_getoptions(int argc, char *argv[]) {
       } else if (strcmp(argv[i], "-nofastdispatch") == 0) {
 	Wrapper_fast_dispatch_mode_set(0);
 	Swig_mark_arg(i);
+      } else if (strcmp(argv[i], "-treedispatch") == 0) {
+	Wrapper_tree_dispatch_mode_set(1);
+	Swig_mark_arg(i);
+      } else if (strcmp(argv[i], "-notreedispatch") == 0) {
+	Wrapper_tree_dispatch_mode_set(0);
+	Swig_mark_arg(i);
       } else if (strcmp(argv[i], "-naturalvar") == 0) {
 	Wrapper_naturalvar_mode_set(1);
 	Swig_mark_arg(i);
@@ -515,6 +528,9 @@ void SWIG_getoptions(int argc, char *argv[]) {
 	Delete(version);
 	Swig_mark_arg(i);
 	SWIG_exit(EXIT_SUCCESS);
+      } else if (strcmp(argv[i], "-compacttypes") == 0) {
+	SwigType_compact_type_table_mode_set(1);
+	Swig_mark_arg(i);
       } else if (strcmp(argv[i], "-small") == 0) {
 	Wrapper_compact_print_mode_set(1);
 	Wrapper_virtual_elimination_mode_set(1);
@@ -823,6 +839,12 @@ void SWIG_getoptions(int argc, char *argv[]) {
       } else if ((strcmp(argv[i], "-debug-typedef") == 0) || (strcmp(argv[i], "-dump_typedef") == 0)) {
 	dump_typedef = 1;
 	Swig_mark_arg(i);
+      } else if (strcmp(argv[i], "-debug-include") == 0) {
+	dump_include = 1;
+	Swig_mark_arg(i);
+      } else if (strcmp(argv[i], "-debug-lookup") == 0) {
+	dump_lookup = 1;
+	Swig_mark_arg(i);
       } else if ((strcmp(argv[i], "-debug-classes") == 0) || (strcmp(argv[i], "-dump_classes") == 0)) {
 	dump_classes = 1;
 	Swig_mark_arg(i);
@@ -1053,6 +1075,8 @@ int SWIG_main(int argc, char *argv[], Language *l) {
 	Seek(fs, 0, SEEK_SET);
 	cpps = Preprocessor_parse(fs);
 	Delete(fs);
+	if (dump_include)
+	  Preprocessor_include_stats();
       } else {
 	cpps = Swig_read_file(df);
 	fclose(df);
@@ -1060,11 +1084,7 @@ int SWIG_main(int argc, char *argv[], Language *l) {
       if (Swig_error_count()) {
 	SWIG_exit(EXIT_FAILURE);
       }
-      if (cpp_only) {
-	Printf(stdout, "%s", cpps);
-	SWIG_exit(EXIT_SUCCESS);
-      }
-      if (depend) {
+      if (depend && !(cpp_only && depend_only)) {
 	if (!no_cpp) {
 	  String *outfile;
           File *f_dependencies_file = 0;
@@ -1123,6 +1143,11 @@ int SWIG_main(int argc, char *argv[], Language *l) {
 	  SWIG_exit(EXIT_FAILURE);
 	}
       }
+      if (cpp_only) {
+	// -MD and -MMD are honoured with -E so that the dependencies are available without a second preprocessor run
+	Printf(stdout, "%s", cpps);
+	SWIG_exit(EXIT_SUCCESS);
+      }
       Seek(cpps, 0, SEEK_SET);
     }
 
@@ -1260,6 +1285,9 @@ int SWIG_main(int argc, char *argv[], Language *l) {
     if (dump_lang_symbols) {
       lang->dumpSymbols();
     }
+    if (dump_lookup) {
+      Swig_name_lookup_stats();
+    }
     if (dump_top & STAGE4) {
       Printf(stdout, "debug-top stage 4\n");
       Swig_print_tree(top);
@@ -30,6 +30,7 @@ struct Overloaded {
 
 static int fast_dispatch_mode = 0;
 static int cast_dispatch_mode = 0;
+static int tree_dispatch_mode = 0;
 
 /* Set fast_dispatch_mode */
 void Wrapper_fast_dispatch_mode_set(int flag) {
@@ -40,6 +41,11 @@ void Wrapper_cast_dispatch_mode_set(int flag) {
   cast_dispatch_mode = flag;
 }
 
+/* Set tree_dispatch_mode */
+void Wrapper_tree_dispatch_mode_set(int flag) {
+  tree_dispatch_mode = flag;
+}
+
 /* -----------------------------------------------------------------------------
  * Swig_overload_rank()
  *
@@ -372,6 +378,12 @@ String *Swig_overload_dispatch_cast(Node *n, const_String_or_char_ptr fmt, int *
   Printf(f, "unsigned long _index = 0;\n");
   Printf(f, "SWIG_TypeRank _rank = 0; \n");
 
+  /* In tree dispatch mode the result of each distinct typecheck is kept in a
+     variable declared here, so that it is not repeated for later candidates */
+  bool share_checks = tree_dispatch_mode || GetFlag(n, "feature:treedispatch");
+  Hash *checks = NewHash();
+  int checks_pos = Len(f);
+
   /* Get a list of methods ranked by precedence values and argument count */
   List *dispatch = Swig_overload_rank(n, true);
   int nfunc = Len(dispatch);
@@ -484,7 +496,23 @@ String *Swig_overload_dispatch_cast(Node *n, const_String_or_char_ptr fmt, int *
 	      Replaceall(tm, "$implicitconv", "0");
 	    }
 	    Replaceall(tm, "$input", tmp);
-	    Printv(f, "{\n", tm, "}\n", NIL);
+	    if (share_checks) {
+	      String *c = Getattr(checks, tm);
+	      if (!c) {
+		String *k = Copy(tm);
+		c = NewStringf("_c%d", Len(checks));
+		Setattr(checks, k, c);
+		Delete(c);
+		Delete(k);
+	      }
+	      Printf(f, "if (%s < 0) {\n", c);
+	      Printv(f, "{\n", tm, "}\n", NIL);
+	      Printf(f, "%s = _v;\n", c);
+	      Printf(f, "}\n");
+	      Printf(f, "_v = %s;\n", c);
+	    } else {
+	      Printv(f, "{\n", tm, "}\n", NIL);
+	    }
 	    fn = i + 1;
 	    Printf(f, "if (!_v) goto check_%d;\n", fn);
 	    Printf(f, "_ranki += _v*_pi;\n");
@@ -528,6 +556,15 @@ String *Swig_overload_dispatch_cast(Node *n, const_String_or_char_ptr fmt, int *
     Delete(coll);
   }
   Delete(dispatch);
+  if (Len(checks)) {
+    String *decl = NewString("int");
+    for (i = 0; i < Len(checks); i++)
+      Printf(decl, "%s _c%d = -1", i ? "," : "", i);
+    Printf(decl, ";\n");
+    Insert(f, checks_pos, decl);
+    Delete(decl);
+  }
+  Delete(checks);
   Printf(f, "dispatch:\n");
   Printf(f, "switch(_index) {\n");
   Printf(f, "%s", sw);
@@ -694,8 +731,210 @@ String *Swig_overload_dispatch_fast(Node *n, const_String_or_char_ptr fmt, int *
   return f;
 }
 
+/* -----------------------------------------------------------------------------
+ * dispatch_tree()
+ *
+ * Emits the dispatch code for the given candidates, in rank order, for a fixed
+ * number of arguments.  Consecutive candidates with the same typecheck on
+ * argument j share one test and continue from argument j+1 inside it.  A test
+ * needed again in another branch keeps its result in a variable _c<n>.  The
+ * first call only counts the tests (emit is false), the second emits the code.
+ * ----------------------------------------------------------------------------- */
+
+struct DispatchTree {
+  String *f;			/* Output                               */
+  List *dispatch;		/* Candidates in rank order             */
+  List *checks;			/* Typecheck code for each argument     */
+  const_String_or_char_ptr fmt;	/* Dispatch format                      */
+  int offset;			/* 1 if argv[0] is self                 */
+  int argc;			/* Argument count being dispatched      */
+  Hash *tests;			/* Variable of each test, "" if unshared */
+  List *shared;			/* Tests kept in a variable             */
+  bool emit;			/* false when counting tests          */
+};
+
+static String *dispatch_check(DispatchTree *t, int candidate, int j) {
+  List *argchecks = Getitem(t->checks, candidate);
+  return (j < Len(argchecks)) ? Getitem(argchecks, j) : 0;
+}
+
+static void dispatch_tree(DispatchTree *t, int *candidates, int count, int j) {
+  if (j == t->argc) {
+    for (int k = 0; k < count; k++) {
+      Node *ni = Getitem(t->dispatch, candidates[k]);
+      String *lfmt = ReplaceFormat(t->fmt, emit_num_arguments(Getattr(ni, "wrap:parms")) + t->offset);
+      Printf(t->f, Char(lfmt), Getattr(ni, "wrap:name"));
+      Printf(t->f, "\n");
+      Delete(lfmt);
+    }
+    return;
+  }
+  int start = 0;
+  while (start < count) {
+    String *tm = dispatch_check(t, candidates[start], j);
+    int end = start + 1;
+    while ((end < count) && (Len(tm) ? Equal(dispatch_check(t, candidates[end], j), tm) : !Len(dispatch_check(t, candidates[end], j))))
+      end++;
+    if (!Len(tm)) {
+      dispatch_tree(t, candidates + start, end - start, j + 1);
+    } else if (!t->emit) {
+      /* Count the tests, a test emitted more than once gets a variable */
+      String *c = Getattr(t->tests, tm);
+      if (!c) {
+	Setattr(t->tests, tm, "");
+      } else if (!Len(c)) {
+	c = NewStringf("_c%d", Len(t->shared));
+	Setattr(t->tests, tm, c);
+	Append(t->shared, c);
+	Delete(c);
+      }
+      dispatch_tree(t, candidates + start, end - start, j + 1);
+    } else {
+      String *c = Getattr(t->tests, tm);
+      if (Len(c)) {
+	Printf(t->f, "if (%s < 0) {\n", c);
+	Printv(t->f, "{\n", tm, "}\n", NIL);
+	Printf(t->f, "%s = _v;\n", c);
+	Printf(t->f, "}\n");
+	Printf(t->f, "if (%s) {\n", c);
+      } else {
+	Printv(t->f, "{\n", tm, "}\n", NIL);
+	Printf(t->f, "if (_v) {\n");
+      }
+      dispatch_tree(t, candidates + start, end - start, j + 1);
+      Printf(t->f, "}\n");
+    }
+    start = end;
+  }
+}
+
+/*
+  Tree dispatch mechanism.
+
+  The dispatcher switches on the argument count and then tests the candidates
+  in the same order as Swig_overload_dispatch().  A typecheck that is the same
+  for several candidates, for example the check on 'self' or on an argument
+  that the candidates share, is run at most once per call and its result kept
+  in a local variable, so each argument is classified by one test of each
+  kind whatever the number of candidates.
+*/
+String *Swig_overload_dispatch_tree(Node *n, const_String_or_char_ptr fmt, int *maxargs) {
+  int i, j;
+
+  *maxargs = 1;
+
+  String *f = NewString("");
+
+  /* Get a list of methods ranked by precedence values and argument count */
+  List *dispatch = Swig_overload_rank(n, true);
+  int nfunc = Len(dispatch);
+  int offset = GetFlag(n, "wrap:this") ? 1 : 0;
+  int min_argc = -1;
+
+  /* The typecheck code of each argument of each candidate, empty if there is none */
+  List *checks = NewList();
+  for (i = 0; i < nfunc; i++) {
+    Node *ni = Getitem(dispatch, i);
+    Parm *pi = Getattr(ni, "wrap:parms");
+    int num_required = emit_num_required(pi) + offset;
+    int num_arguments = emit_num_arguments(pi) + offset;
+    if (num_arguments > *maxargs)
+      *maxargs = num_arguments;
+    if ((min_argc < 0) || (num_required < min_argc))
+      min_argc = num_required;
+
+    List *argchecks = NewList();
+    j = 0;
+    Parm *pj = pi;
+    while (pj) {
+      if (checkAttribute(pj, "tmap:in:numinputs", "0")) {
+	pj = Getattr(pj, "tmap:in:next");
+	continue;
+      }
+      String *tm = Getattr(pj, "tmap:typecheck");
+      if (tm) {
+	String *tmp = NewStringf(argv_template_string, j + offset);
+	tm = Copy(tm);
+	Replaceid(tm, Getattr(pj, "lname"), "_v");
+	String *conv = Getattr(pj, "implicitconv");
+	Replaceall(tm, "$implicitconv", conv ? conv : "0");
+	Replaceall(tm, "$input", tmp);
+	Append(argchecks, tm);
+	Delete(tm);
+	Delete(tmp);
+      } else {
+	Append(argchecks, "");
+      }
+      if (!Getattr(pj, "tmap:in:SWIGTYPE") && Getattr(pj, "tmap:typecheck:SWIGTYPE")) {
+	/* we emit  a warning if the argument defines the 'in' typemap, but not the 'typecheck' one */
+	Swig_warning(WARN_TYPEMAP_TYPECHECK_UNDEF, Getfile(ni), Getline(ni),
+		     "Overloaded method %s with no explicit typecheck typemap for arg %d of type '%s'\n",
+		     Swig_name_decl(n), j, SwigType_str(Getattr(pj, "type"), 0));
+      }
+      Parm *pk = Getattr(pj, "tmap:in:next");
+      if (pk)
+	pj = pk;
+      else
+	pj = nextSibling(pj);
+      j++;
+    }
+    Append(checks, argchecks);
+    Delete(argchecks);
+  }
+
+  if (nfunc)
+    Printf(f, "switch (%s) {\n", argc_template_string);
+  int *candidates = new int[nfunc ? nfunc : 1];
+  for (int argc = min_argc; nfunc && argc <= *maxargs; argc++) {
+    int num_candidates = 0;
+    for (i = 0; i < nfunc; i++) {
+      Parm *pi = Getattr(Getitem(dispatch, i), "wrap:parms");
+      if ((argc >= emit_num_required(pi) + offset) && (argc <= emit_num_arguments(pi) + offset))
+	candidates[num_candidates++] = i;
+    }
+    if (!num_candidates)
+      continue;
+
+    DispatchTree tree;
+    tree.f = NewString("");
+    tree.dispatch = dispatch;
+    tree.checks = checks;
+    tree.fmt = fmt;
+    tree.offset = offset;
+    tree.argc = argc;
+    tree.tests = NewHash();
+    tree.shared = NewList();
+    tree.emit = false;
+    dispatch_tree(&tree, candidates, num_candidates, 0);
+    Delete(tree.f);
+    tree.f = f;
+    tree.emit = true;
+
+    Printf(f, "case %d: {\n", argc);
+    if (Len(tree.tests))
+      Printf(f, "int _v;\n");
+    for (i = 0; i < Len(tree.shared); i++)
+      Printf(f, "int _c%d = -1;\n", i);
+    dispatch_tree(&tree, candidates, num_candidates, 0);
+    Printf(f, "break;\n");
+    Printf(f, "}\n");		/* braces closes "case" for this argument count */
+    Delete(tree.tests);
+    Delete(tree.shared);
+  }
+  delete[]candidates;
+  if (nfunc)
+    Printf(f, "}\n");
+  Delete(checks);
+  Delete(dispatch);
+  return f;
+}
+
 String *Swig_overload_dispatch(Node *n, const_String_or_char_ptr fmt, int *maxargs) {
 
+  if (tree_dispatch_mode || GetFlag(n, "feature:treedispatch")) {
+    return Swig_overload_dispatch_tree(n, fmt, maxargs);
+  }
+
   if (fast_dispatch_mode || GetFlag(n, "feature:fastdispatch")) {
     return Swig_overload_dispatch_fast(n, fmt, maxargs);
   }
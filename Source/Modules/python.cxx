@@ -35,6 +35,8 @@ static String *global_name = 0;
 static int shadow = 1;
 static int use_kw = 0;
 static int director_method_index = 0;
+static List *director_method_names = 0;
+static List *director_inner_names = 0;
 static int builtin = 0;
 
 static File *f_begin = 0;
@@ -86,7 +88,7 @@ static int shadowimport = 1;
 static int buildnone = 0;
 static int nobuildnone = 0;
 static int safecstrings = 0;
-static int dirvtable = 0;
+static int dirvtable = 1;
 static int doxygen = 0;
 static int proxydel = 1;
 static int fastunpack = 0;
@@ -121,7 +123,7 @@ Python Options (available with -python)\n\
      -classic        - Use classic classes only\n\
      -classptr       - Generate shadow 'ClassPtr' as in older swig versions\n\
      -cppcast        - Enable C++ casting operators (default) \n\
-     -dirvtable      - Generate a pseudo virtual table for directors for faster dispatch \n\
+     -dirvtable      - Generate a pseudo virtual table for directors for faster dispatch (default)\n\
      -doxygen        - Convert C++ doxygen comments to pydoc comments in proxy classes \n\
      -debug-doxygen-parser     - Display doxygen parser module debugging information\n\
      -debug-doxygen-translator - Display doxygen translator module debugging information\n\
@@ -142,7 +144,7 @@ static const char *usage2 = (char *) "\
      -nobuildnone    - Access Py_None directly (default in non-Windows systems)\n\
      -nocastmode     - Disable the casting mode (default)\n\
      -nocppcast      - Disable C++ casting operators, useful for generating bugs\n\
-     -nodirvtable    - Don't use the virtual table feature, resolve the python method each time (default)\n\
+     -nodirvtable    - Don't use the virtual table feature, resolve the python method each time \n\
      -noexcept       - No automatic exception handling\n\
      -noextranative  - Don't use extra native C++ wraps for std containers when possible (default) \n\
      -nofastinit     - Use traditional init mechanism for classes \n\
@@ -190,7 +192,29 @@ static void printSlot(File *f, const String *slotval, const char *slotname, cons
   Delete(slotval_override);
 }
 
-static String *getClosure(String *functype, String *wrapper, int funpack = 0) {
+/* Slot function types whose closures can call a wrapper's __SWIG_argv entry point */
+static const char *argv_functypes[] = {
+  "binaryfunc", "SWIGPY_ARGV_BINARYFUNC_CLOSURE",
+  "ternaryfunc", "SWIGPY_ARGV_TERNARYFUNC_CLOSURE",
+  "ssizeargfunc", "SWIGPY_ARGV_SSIZEARGFUNC_CLOSURE",
+  "ssizessizeargfunc", "SWIGPY_ARGV_SSIZESSIZEARGFUNC_CLOSURE",
+  "ssizeobjargproc", "SWIGPY_ARGV_SSIZEOBJARGPROC_CLOSURE",
+  "ssizessizeobjargproc", "SWIGPY_ARGV_SSIZESSIZEOBJARGPROC_CLOSURE",
+  "objobjargproc", "SWIGPY_ARGV_OBJOBJARGPROC_CLOSURE",
+  NULL
+};
+
+static const char *getArgvClosure(const String *functype) {
+  if (!functype)
+    return NULL;
+  for (int i = 0; argv_functypes[i] != NULL; i += 2) {
+    if (!strcmp(Char(functype), argv_functypes[i]))
+      return argv_functypes[i + 1];
+  }
+  return NULL;
+}
+
+static String *getClosure(String *functype, String *wrapper, int funpack = 0, bool argv = false) {
   static const char *functypes[] = {
     "unaryfunc", "SWIGPY_UNARYFUNC_CLOSURE",
     "destructor", "SWIGPY_DESTRUCTOR_CLOSURE",
@@ -234,7 +258,10 @@ static String *getClosure(String *functype, String *wrapper, int funpack = 0) {
     return NULL;
   char *c = Char(functype);
   int i;
-  if (funpack) {
+  const char *argv_closure = argv ? getArgvClosure(functype) : NULL;
+  if (argv_closure) {
+    return NewStringf("%s(%s)", argv_closure, wrapper);
+  } else if (funpack) {
     for (i = 0; funpack_functypes[i] != NULL; i += 2) {
       if (!strcmp(c, funpack_functypes[i]))
 	return NewStringf("%s(%s)", funpack_functypes[i + 1], wrapper);
@@ -1305,6 +1332,7 @@ public:
     // by post processing tools
     Setattr(n, "python:docstring", doc);
     Setattr(n, "python:autodoc", autodoc);
+    Delete(doxygen_comment);
 
     return doc;
   }   
@@ -1902,10 +1930,29 @@ public:
     Append(methods, "},\n");
   }
 
+  /* ------------------------------------------------------------
+   * argvTupleWrapper()
+   *
+   * Emit the METH_VARARGS/METH_O entry point for a wrapper whose body
+   * takes an argument vector (wname__SWIG_argv), as used by the builtin
+   * slot closures.
+   * ------------------------------------------------------------ */
+  void argvTupleWrapper(String *linkage, String *wname) {
+    Wrapper *f = NewWrapper();
+    Printv(f->def, linkage, "PyObject *", wname, "(PyObject *self, PyObject *args) {", NIL);
+    Append(f->code, "if (args && PyTuple_Check(args)) {\n");
+    Printf(f->code, "return %s__SWIG_argv(self, (int)PyTuple_GET_SIZE(args), &PyTuple_GET_ITEM(args, 0));\n", wname);
+    Append(f->code, "}\n");
+    Printf(f->code, "return %s__SWIG_argv(self, args ? 1 : 0, &args);\n", wname);
+    Append(f->code, "}\n");
+    Wrapper_print(f, f_wrappers);
+    DelWrapper(f);
+  }
+
   /* ------------------------------------------------------------
    * dispatchFunction()
    * ------------------------------------------------------------ */
-  void dispatchFunction(Node *n, String *linkage, int funpack = 0, bool builtin_self = false, bool builtin_ctor = false, bool director_class = false) {
+  void dispatchFunction(Node *n, String *linkage, int funpack = 0, bool builtin_self = false, bool builtin_ctor = false, bool director_class = false, bool argv_wrapper = false) {
     /* Last node in overloaded chain */
 
     bool add_self = builtin_self && (!builtin_ctor || director_class);
@@ -1928,7 +1975,11 @@ public:
     String *symname = Getattr(n, "sym:name");
     String *wname = Swig_name_wrapper(symname);
 
-    Printv(f->def, linkage, builtin_ctor ? "int " : "PyObject *", wname, "(PyObject *self, PyObject *args) {", NIL);
+    if (argv_wrapper) {
+      Printv(f->def, linkage, "PyObject *", wname, "__SWIG_argv(PyObject *self, int nobjs, PyObject **swig_args) {", NIL);
+    } else {
+      Printv(f->def, linkage, builtin_ctor ? "int " : "PyObject *", wname, "(PyObject *self, PyObject *args) {", NIL);
+    }
 
     Wrapper_add_local(f, "argc", "int argc");
     Printf(tmp, "PyObject *argv[%d]", maxargs + 1);
@@ -1948,7 +1999,10 @@ public:
 	Append(f->code, "argc++;\n");
     } else {
       String *iname = Getattr(n, "sym:name");
-      Printf(f->code, "if (!(argc = SWIG_Python_UnpackTuple(args,\"%s\",0,%d,argv%s))) SWIG_fail;\n", iname, maxargs, add_self ? "+1" : "");
+      if (argv_wrapper)
+	Printf(f->code, "if (!(argc = SWIG_Python_UnpackArgs(swig_args,nobjs,\"%s\",0,%d,argv+1))) SWIG_fail;\n", iname, maxargs);
+      else
+	Printf(f->code, "if (!(argc = SWIG_Python_UnpackTuple(args,\"%s\",0,%d,argv%s))) SWIG_fail;\n", iname, maxargs, add_self ? "+1" : "");
       if (add_self)
 	Append(f->code, "argv[0] = self;\n");
       else
@@ -1981,6 +2035,8 @@ public:
     }
     Printv(f->code, "}\n", NIL);
     Wrapper_print(f, f_wrappers);
+    if (argv_wrapper)
+      argvTupleWrapper(linkage, wname);
     Node *p = Getattr(n, "sym:previousSibling");
     if (!builtin_self)
       add_method(symname, wname, 0, p);
@@ -2180,9 +2236,16 @@ public:
 	over_varargs = true;
     }
 
-    int funpack = modernargs && fastunpack && !varargs && !over_varargs && !allow_kwargs;
+    /* Builtin slot closures for functions taking arguments call an argument
+       vector entry point, so that no tuple is built for each slot call.
+       Non-overloaded slot functions always use the fast unpack code for this. */
+    String *slot_functype = builtin_self && !builtin_ctor && Getattr(n, "feature:python:slot") ? Getattr(n, "feature:python:slot:functype") : 0;
+    bool slot_funpack = !overname && getArgvClosure(slot_functype);
+
+    int funpack = ((modernargs && fastunpack) || slot_funpack) && !varargs && !over_varargs && !allow_kwargs;
     int noargs = funpack && (tuple_required == 0 && tuple_arguments == 0);
     int onearg = funpack && (tuple_required == 1 && tuple_arguments == 1);
+    bool argv_wrapper = funpack && !noargs && (overname || !onearg) && getArgvClosure(slot_functype);
 
     if (builtin && funpack && !overname && !builtin_ctor && !GetFlag(n, "feature:compactdefaultargs")) {
       String *argattr = NewStringf("%d", tuple_arguments);
@@ -2332,7 +2395,8 @@ public:
       Printv(f->locals, "  char *  kwnames[] = ", kwargs, ";\n", NIL);
     }
 
-    if (use_parse || allow_kwargs || !modernargs) {
+    if (use_parse || allow_kwargs || (!modernargs && !slot_funpack)) {
+      argv_wrapper = false;
       if (builtin && in_class && tuple_arguments == 0) {
 	Printf(parse_args, "    if (args && PyTuple_Check(args) && PyTuple_GET_SIZE(args) > 0) SWIG_fail;\n");
       } else {
@@ -2351,6 +2415,9 @@ public:
 	    Printv(f->def, linkage, wrap_return, wname, "(PyObject *", self_param, ", int nobjs, PyObject **swig_obj) {", NIL);
 	  }
 	  Printf(parse_args, "if ((nobjs < %d) || (nobjs > %d)) SWIG_fail;\n", num_required, num_arguments);
+	} else if (argv_wrapper) {
+	  Printv(f->def, linkage, wrap_return, wname, "__SWIG_argv(PyObject *self, int nobjs, PyObject **swig_args) {", NIL);
+	  Printf(parse_args, "if (!SWIG_Python_UnpackArgs(swig_args,nobjs,\"%s\",%d,%d,swig_obj)) SWIG_fail;\n", iname, num_fixed_arguments, tuple_arguments);
 	} else {
 	  if (noargs) {
 	    Printv(f->def, linkage, wrap_return, wname, "(PyObject *", self_param, ", PyObject *args) {", NIL);
@@ -2645,6 +2712,8 @@ public:
 
     /* Dump the function out */
     Wrapper_print(f, f_wrappers);
+    if (argv_wrapper && !overname)
+      argvTupleWrapper(linkage, wname);
 
     /* If varargs.  Need to emit a varargs stub */
     if (varargs) {
@@ -2693,7 +2762,7 @@ public:
       }
     } else {
       if (!Getattr(n, "sym:nextSibling")) {
-	dispatchFunction(n, linkage, funpack, builtin_self, builtin_ctor, director_class);
+	dispatchFunction(n, linkage, funpack, builtin_self, builtin_ctor, director_class, argv_wrapper);
       }
     }
 
@@ -2739,7 +2808,7 @@ public:
       String *slot = Getattr(n, "feature:python:slot");
       if (slot) {
 	String *func_type = Getattr(n, "feature:python:slot:functype");
-	String *closure_decl = getClosure(func_type, wrapper_name, overname ? 0 : funpack);
+	String *closure_decl = getClosure(func_type, wrapper_name, overname ? 0 : funpack, argv_wrapper);
 	String *feature_name = NewStringf("feature:python:%s", slot);
 	String *closure_name = Copy(wrapper_name);
 	if (closure_decl) {
@@ -3122,47 +3191,70 @@ public:
 
     if (dirprot_mode()) {
       /*
-         This implementation uses a std::map<std::string,int>.
-
-         It should be possible to rewrite it using a more elegant way,
-         like copying the Java approach for the 'override' array.
-
-         But for now, this seems to be the least intrusive way.
+         The director methods flag the protected method being called back
+         by its index in a bitset. The wrappers only know the name of the
+         method, so swig_get_inner() maps the name to the index first.
        */
+      int inner_count = Len(director_inner_names);
       Printf(f_directors_h, "\n\n");
       Printf(f_directors_h, "/* Internal Director utilities */\n");
       Printf(f_directors_h, "public:\n");
       Printf(f_directors_h, "    bool swig_get_inner(const char* swig_protected_method_name) const {\n");
-      Printf(f_directors_h, "      std::map<std::string, bool>::const_iterator iv = swig_inner.find(swig_protected_method_name);\n");
-      Printf(f_directors_h, "      return (iv != swig_inner.end() ? iv->second : false);\n");
+      if (inner_count) {
+	Printf(f_directors_h, "      size_t swig_index = swig_inner_index(swig_protected_method_name);\n");
+	Printf(f_directors_h, "      return (swig_index != %d ? swig_inner[swig_index] : false);\n", inner_count);
+      } else {
+	Printf(f_directors_h, "      return false;\n");
+      }
       Printf(f_directors_h, "    }\n\n");
 
-      Printf(f_directors_h, "    void swig_set_inner(const char* swig_protected_method_name, bool val) const\n");
-      Printf(f_directors_h, "    { swig_inner[swig_protected_method_name] = val;}\n\n");
-      Printf(f_directors_h, "private:\n");
-      Printf(f_directors_h, "    mutable std::map<std::string, bool> swig_inner;\n");
-
+      Printf(f_directors_h, "    void swig_set_inner(const char* swig_protected_method_name, bool val) const {\n");
+      if (inner_count) {
+	Printf(f_directors_h, "      size_t swig_index = swig_inner_index(swig_protected_method_name);\n");
+	Printf(f_directors_h, "      if (swig_index != %d) swig_inner[swig_index] = val;\n", inner_count);
+      }
+      Printf(f_directors_h, "    }\n\n");
+      if (inner_count) {
+	Printf(f_directors_h, "private:\n");
+	Printf(f_directors_h, "    static size_t swig_inner_index(const char* swig_protected_method_name) {\n");
+	for (int i = 0; i < inner_count; i++) {
+	  Printf(f_directors_h, "      if (strcmp(swig_protected_method_name, \"%s\") == 0) return %d;\n", Getitem(director_inner_names, i), i);
+	}
+	Printf(f_directors_h, "      return %d;\n", inner_count);
+	Printf(f_directors_h, "    }\n\n");
+	Printf(f_directors_h, "    mutable std::bitset<%d> swig_inner;\n", inner_count);
+      }
     }
     if (director_method_index) {
+      /* the python method names are interned once, at module initialization */
+      Printf(f_directors_h, "\n\n");
+      Printf(f_directors_h, "/* Python method names */\n");
+      Printf(f_directors_h, "public:\n");
+      Printf(f_directors_h, "    static PyObject *swig_method_names[%d];\n", director_method_index);
+      Printf(f_directors, "PyObject *SwigDirector_%s::swig_method_names[%d];\n\n", classname, director_method_index);
+      for (int i = 0; i < director_method_index; i++) {
+	Printf(f_init, "SwigDirector_%s::swig_method_names[%d] = SWIG_Python_str_InternFromChar(\"%s\");\n", classname, i, Getitem(director_method_names, i));
+      }
+
       Printf(f_directors_h, "\n\n");
       Printf(f_directors_h, "#if defined(SWIG_PYTHON_DIRECTOR_VTABLE)\n");
       Printf(f_directors_h, "/* VTable implementation */\n");
       Printf(f_directors_h, "    PyObject *swig_get_method(size_t method_index, const char *method_name) const {\n");
-      Printf(f_directors_h, "      PyObject *method = vtable[method_index];\n");
+      Printf(f_directors_h, "      PyObject *method = vtable.get(swig_get_self(), method_index, swig_method_names[method_index]);\n");
       Printf(f_directors_h, "      if (!method) {\n");
-      Printf(f_directors_h, "        swig::SwigVar_PyObject name = SWIG_Python_str_FromChar(method_name);\n");
-      Printf(f_directors_h, "        method = PyObject_GetAttr(swig_get_self(), name);\n");
-      Printf(f_directors_h, "        if (!method) {\n");
-      Printf(f_directors_h, "          std::string msg = \"Method in class %s doesn't exist, undefined \";\n", classname);
-      Printf(f_directors_h, "          msg += method_name;\n");
-      Printf(f_directors_h, "          Swig::DirectorMethodException::raise(msg.c_str());\n");
-      Printf(f_directors_h, "        }\n");
-      Printf(f_directors_h, "        vtable[method_index] = method;\n");
+      Printf(f_directors_h, "        std::string msg = \"Method in class %s doesn't exist, undefined \";\n", classname);
+      Printf(f_directors_h, "        msg += method_name;\n");
+      Printf(f_directors_h, "        Swig::DirectorMethodException::raise(msg.c_str());\n");
       Printf(f_directors_h, "      }\n");
       Printf(f_directors_h, "      return method;\n");
       Printf(f_directors_h, "    }\n");
       Printf(f_directors_h, "private:\n");
-      Printf(f_directors_h, "    mutable swig::SwigVar_PyObject vtable[%d];\n", director_method_index);
+      Printf(f_directors_h, "    mutable Swig::DirectorVtable<%d> vtable;\n", director_method_index);
+      Printf(f_directors_h, "#endif\n\n");
+      Printf(f_directors_h, "#if defined(SWIG_PYTHON_DIRECTOR_OVERRIDE_CACHE)\n");
+      Printf(f_directors_h, "/* Methods overridden in python */\n");
+      Printf(f_directors_h, "private:\n");
+      Printf(f_directors_h, "    Swig::DirectorOverrides<%d> swig_override;\n", director_method_index);
       Printf(f_directors_h, "#endif\n\n");
     }
 
@@ -4629,6 +4721,10 @@ public:
  * --------------------------------------------------------------- */
 int PYTHON::classDirectorMethods(Node *n) {
   director_method_index = 0;
+  Delete(director_method_names);
+  director_method_names = NewList();
+  Delete(director_inner_names);
+  director_inner_names = NewList();
   return Language::classDirectorMethods(n);
 }
 
@@ -4883,6 +4979,26 @@ int PYTHON::classDirectorMethod(Node *n, Node *parent, String *super) {
     /* add the method name as a PyString */
     String *pyname = Getattr(n, "sym:name");
 
+    /* call the C++ implementation directly if the python class doesn't
+       override the method, unless the proxy method adds python code */
+    if (!pure_virtual && !have_addtofunc(n) && !Getattr(n, "feature:shadow")) {
+      SwigType *ptype = Copy(c_classname);
+      SwigType_add_pointer(ptype);
+      String *mangle = SwigType_manglestr(ptype);
+      String *super_call = Swig_method_call(super, l);
+      Append(w->code, "#if defined(SWIG_PYTHON_DIRECTOR_OVERRIDE_CACHE)\n");
+      Printf(w->code, "if (!swig_override.overrides(swig_get_self(), SWIGTYPE%s, %d, \"%s\")) {\n", mangle, director_method_index, pyname);
+      if (is_void)
+	Printf(w->code, "%s;\nreturn;\n", super_call);
+      else
+	Printf(w->code, "return %s;\n", super_call);
+      Append(w->code, "}\n");
+      Append(w->code, "#endif\n");
+      Delete(super_call);
+      Delete(mangle);
+      Delete(ptype);
+    }
+
     int allow_thread = threads_enable(n);
 
     if (allow_thread) {
@@ -4894,19 +5010,28 @@ int PYTHON::classDirectorMethod(Node *n, Node *parent, String *super) {
     Printv(w->code, wrap_args, NIL);
 
     /* pass the method call on to the Python object */
+    int inner_index = -1;
     if (dirprot_mode() && !is_public(n)) {
-      Printf(w->code, "swig_set_inner(\"%s\", true);\n", name);
+      for (inner_index = 0; inner_index < Len(director_inner_names); inner_index++) {
+	if (Equal(Getitem(director_inner_names, inner_index), name))
+	  break;
+      }
+      if (inner_index == Len(director_inner_names))
+	Append(director_inner_names, name);
+      Printf(w->code, "swig_inner[%d] = true;\n", inner_index);
     }
 
 
     Append(w->code, "if (!swig_get_self()) {\n");
     Printf(w->code, "  Swig::DirectorException::raise(\"'self' uninitialized, maybe you forgot to call %s.__init__.\");\n", classname);
     Append(w->code, "}\n");
+    int method_index = director_method_index++;
+    Append(director_method_names, pyname);
     Append(w->code, "#if defined(SWIG_PYTHON_DIRECTOR_VTABLE)\n");
-    Printf(w->code, "const size_t swig_method_index = %d;\n", director_method_index++);
+    Printf(w->code, "const size_t swig_method_index = %d;\n", method_index);
     Printf(w->code, "const char * const swig_method_name = \"%s\";\n", pyname);
 
-    Append(w->code, "PyObject* method = swig_get_method(swig_method_index, swig_method_name);\n");
+    Append(w->code, "swig::SwigVar_PyObject method = swig_get_method(swig_method_index, swig_method_name);\n");
     if (Len(parse_args) > 0) {
       if (use_parse || !modernargs) {
 	Printf(w->code, "swig::SwigVar_PyObject %s = PyObject_CallFunction(method, (char *)\"(%s)\" %s);\n", Swig_cresult_name(), parse_args, arglist);
@@ -4926,21 +5051,19 @@ int PYTHON::classDirectorMethod(Node *n, Node *parent, String *super) {
       if (use_parse || !modernargs) {
 	Printf(w->code, "swig::SwigVar_PyObject %s = PyObject_CallMethod(swig_get_self(), (char *)\"%s\", (char *)\"(%s)\" %s);\n", Swig_cresult_name(), pyname, parse_args, arglist);
       } else {
-	Printf(w->code, "swig::SwigVar_PyObject swig_method_name = SWIG_Python_str_FromChar((char *)\"%s\");\n", pyname);
-	Printf(w->code, "swig::SwigVar_PyObject %s = PyObject_CallMethodObjArgs(swig_get_self(), (PyObject *) swig_method_name %s, NULL);\n", Swig_cresult_name(), arglist);
+	Printf(w->code, "swig::SwigVar_PyObject %s = PyObject_CallMethodObjArgs(swig_get_self(), swig_method_names[%d] %s, NULL);\n", Swig_cresult_name(), method_index, arglist);
       }
     } else {
       if (!modernargs) {
 	Printf(w->code, "swig::SwigVar_PyObject %s = PyObject_CallMethod(swig_get_self(), (char *) \"%s\", NULL);\n", Swig_cresult_name(), pyname);
       } else {
-	Printf(w->code, "swig::SwigVar_PyObject swig_method_name = SWIG_Python_str_FromChar((char *)\"%s\");\n", pyname);
-	Printf(w->code, "swig::SwigVar_PyObject %s = PyObject_CallMethodObjArgs(swig_get_self(), (PyObject *) swig_method_name, NULL);\n", Swig_cresult_name());
+	Printf(w->code, "swig::SwigVar_PyObject %s = PyObject_CallMethodObjArgs(swig_get_self(), swig_method_names[%d], NULL);\n", Swig_cresult_name(), method_index);
       }
     }
     Append(w->code, "#endif\n");
 
     if (dirprot_mode() && !is_public(n))
-      Printf(w->code, "swig_set_inner(\"%s\", false);\n", name);
+      Printf(w->code, "swig_inner[%d] = false;\n", inner_index);
 
     /* exception handling */
     tm = Swig_typemap_lookup("director:except", n, Swig_cresult_name(), 0);
@@ -330,6 +330,7 @@ protected:
   int DumpCode(Node *n);
   
   int OutputMemberReferenceMethod(String *className, int isSet, List *el, File *out);
+  int OutputVectorGetter(String *iname, String *wname, int addCopyParam);
   int OutputArrayMethod(String *className, List *el, File *out);
   int OutputClassMemberTable(Hash *tb, File *out);
   int OutputClassMethodsTable(File *out);
@@ -424,6 +425,10 @@ protected:
   // R for dynamic lookup. 
   Hash *registrationTable;
   Hash *functionPointerProxyTable;
+
+  // R expressions that call the C getter of a plain data member directly,
+  // keyed by the name of the R accessor function they stand in for.
+  Hash *directGetters;
   
   List *namespaceFunctions;
   List *namespaceMethods;
@@ -478,6 +483,7 @@ R::R() :
   SMethodInfo(0),
   registrationTable(0),
   functionPointerProxyTable(0),
+  directGetters(0),
   namespaceFunctions(0),
   namespaceMethods(0),
   namespaceClasses(0),
@@ -1005,31 +1011,34 @@ int R::OutputClassMemberTable(Hash *tb, File *out) {
 /*******************************************************************
  Write the methods for $ or $<- for accessing a member field in an 
  struct or union (or class).
+ The accessor functions are collected once per class into hashed
+ environments (.__get_p<class>, .__call_p<class> and .__set_p<class>)
+ and the methods look the name up in these with an exact match.
  className - the name of the struct or union (e.g. Bar for struct Bar)
  isSet - a logical value indicating whether the method is for 
            modifying ($<-) or accessing ($) the member field.
- el - a list of length  2 * # accessible member elements  + 1.
-      The first element is the name of the class. 
-      The other pairs are  member name and the name of the R function to access it.
+ el - a list of length  3 * # accessible member elements.
+      Each triple is the member name, the name of the R function 
+      to access it and the code of that function.
  out - the stream where we write the code.
 ********************************************************************/
 int R::OutputMemberReferenceMethod(String *className, int isSet, 
 				   List *el, File *out) {
   int numMems = Len(el), j;
-  int varaccessor = 0;
   if (numMems == 0) 
     return SWIG_OK;
   
   Wrapper *f = NewWrapper(), *attr = NewWrapper();
+  String *rclassName = getRClassName(className);
+  String *fields = NewStringf(".__%s_p%s", isSet ? "set" : "get", rclassName);
+  String *methods = NewStringf(".__call_p%s", rclassName);
+  String *fieldList = NewString("");
+  String *methodList = NewString("");
   
   Printf(f->def, "function(x, name%s)", isSet ? ", value" : "");
   Printf(attr->def, "function(x, i, j, ...%s)", isSet ? ", value" : "");
-  
-  Printf(f->code, "{\n");
-  Printf(f->code, "%saccessorFuns = list(", tab8);
 
   Node *itemList = NewHash();
-  bool has_prev = false;
   for(j = 0; j < numMems; j+=3) {
     String *item = Getitem(el, j);
     if (Getattr(itemList, item)) 
@@ -1040,9 +1049,6 @@ int R::OutputMemberReferenceMethod(String *className, int isSet,
     char *ptr = Char(dup);
     ptr = &ptr[Len(dup) - 3];
     
-    if (!strcmp(ptr, "get"))
-      varaccessor++;
-
     String *pitem;
     if (!Strcmp(item, "operator ()")) {
       pitem = NewString("call");
@@ -1055,73 +1061,55 @@ int R::OutputMemberReferenceMethod(String *className, int isSet,
     } else {
       pitem = Copy(item);
     }
-    if (has_prev) 
-      Printf(f->code, ", ");
-    Printf(f->code, "'%s' = %s", pitem, dup);
-    has_prev = true;
+
+    /* Data members (and everything assigned through $<-) are called on 
+       the object, other methods are returned as a closure over it. */
+    String *list = (isSet || !strcmp(ptr, "get")) ? fieldList : methodList;
+    String *direct = directGetters ? Getattr(directGetters, dup) : 0;
+    Printf(list, "%s'%s' = %s", Len(list) ? ",\n    " : "", pitem,
+	   direct ? direct : dup);
     Delete(pitem);
   }
   Delete(itemList);
-  Printf(f->code, ");\n");
-  
-  if (!isSet && varaccessor > 0) {
-    Printf(f->code, "%svaccessors = c(", tab8);
-    int vcount = 0;
-    for(j = 0; j < numMems; j+=3) {
-      String *item = Getitem(el, j);
-      String *dup = Getitem(el, j + 1);
-      char *ptr = Char(dup);
-      ptr = &ptr[Len(dup) - 3];
-      
-      if (!strcmp(ptr, "get")) {
-	vcount++;
-	Printf(f->code, "'%s'%s", item, vcount < varaccessor ? ", " : "");
-      }
-    }
-    Printf(f->code, ");\n");
-  }
-  
-  
-  /*    Printv(f->code, tab8,
-	"idx = pmatch(name, names(accessorFuns))\n",
-	tab8,
-	"if(is.na(idx)) {\n",
-	tab8, tab4, 
-	"stop(\"No ", (isSet ? "modifiable" : "accessible"), " field named \", name, \" in ", className,
-	": fields are \", paste(names(accessorFuns), sep = \", \")", 
-	")", "\n}\n", NIL); */
-  Printv(f->code, ";", tab8,
-	 "idx = pmatch(name, names(accessorFuns));\n",
-	 tab8,
-	 "if(is.na(idx)) \n",
-	 tab8, tab4, NIL);
-  Printf(f->code, "return(callNextMethod(x, name%s));\n",
-	 isSet ? ", value" : "");
-  Printv(f->code, tab8, "f = accessorFuns[[idx]];\n", NIL);
-  if(isSet) {
+
+  Printf(out, "# Start of accessor method for %s\n", className);
+  if (Len(fieldList))
+    Printf(out, "`%s` = list2env(list(\n    %s), hash = TRUE);\n", 
+	   fields, fieldList);
+  if (Len(methodList))
+    Printf(out, "`%s` = list2env(list(\n    %s), hash = TRUE);\n", 
+	   methods, methodList);
+  
+  Printf(f->code, "{\n");
+  if (isSet) {
+    Printf(f->code, "%sf = `%s`[[name]];\n", tab8, fields);
+    Printf(f->code, "%sif(is.null(f))\n%s%sreturn(callNextMethod(x, name, value));\n", 
+	   tab8, tab8, tab4);
     Printv(f->code, tab8, "f(x, value);\n", NIL);
     Printv(f->code, tab8, "x;\n", NIL); // make certain to return the S value.
   } else {
-    if (varaccessor) {
-      Printv(f->code, tab8,
-	     "if (is.na(match(name, vaccessors))) function(...){f(x, ...)} else f(x);\n", NIL);
-    } else {
+    if (Len(fieldList)) {
+      Printf(f->code, "%sf = `%s`[[name]];\n", tab8, fields);
+      Printf(f->code, "%sif(!is.null(f))\n%s%sreturn(f(x));\n", tab8, tab8, tab4);
+    }
+    if (Len(methodList)) {
+      Printf(f->code, "%sf = `%s`[[name]];\n", tab8, methods);
+      Printf(f->code, "%sif(is.null(f))\n%s%sreturn(callNextMethod(x, name));\n", 
+	     tab8, tab8, tab4);
       Printv(f->code, tab8, "function(...){f(x, ...)};\n", NIL);
+    } else {
+      Printv(f->code, tab8, "callNextMethod(x, name);\n", NIL);
     }
   }
   Printf(f->code, "}\n");
   
-  
-  Printf(out, "# Start of accessor method for %s\n", className);
   Printf(out, "setMethod('$%s', '_p%s', ",
-	 isSet ? "<-" : "", 
-	 getRClassName(className)); 
+	 isSet ? "<-" : "", rclassName); 
   Wrapper_print(f, out);
   Printf(out, ");\n");
   
   if(isSet) {
-    Printf(out, "setMethod('[[<-', c('_p%s', 'character'),", 
-	   getRClassName(className)); 
+    Printf(out, "setMethod('[[<-', c('_p%s', 'character'),", rclassName); 
     Insert(f->code, 2, "name = i;\n");
     Printf(attr->code, "%s", f->code);
     Wrapper_print(attr, out);
@@ -1130,12 +1118,55 @@ int R::OutputMemberReferenceMethod(String *className, int isSet,
   
   DelWrapper(attr);
   DelWrapper(f);
+  Delete(rclassName);
+  Delete(fields);
+  Delete(methods);
+  Delete(fieldList);
+  Delete(methodList);
   
   Printf(out, "# end of accessor method for %s\n", className);
   
   return SWIG_OK;
 }
 
+/*******************************************************************
+ Write a vectorized version of the getter of a plain data member.
+ <class>_<member>_vget(objs) takes a list of references and returns 
+ the member of each of them from a single .Call, as an atomic vector 
+ when every value is a scalar of the same basic type.
+ iname - the name of the R getter function, e.g. Bar_x_get
+ wname - the name of the C routine that implements it
+ addCopyParam - whether the getter takes a .copy argument
+********************************************************************/
+int R::OutputVectorGetter(String *iname, String *wname, int addCopyParam) {
+  String *vname = Copy(iname);
+  String *vwname = Copy(wname);
+  Insert(vname, Len(vname) - 3, "v");
+  Insert(vwname, Len(vwname) - 3, "v");
+
+  Printf(f_wrapper, "SWIGEXPORT SEXP\n%s ( SEXP objs%s)\n{\n", vwname, 
+	 addCopyParam ? ", SEXP s_swig_copy" : "");
+  if (addCopyParam)
+    Printf(f_wrapper, "  return R_SWIG_applyGetter(objs, NULL, %s, s_swig_copy);\n", wname);
+  else
+    Printf(f_wrapper, "  return R_SWIG_applyGetter(objs, %s, NULL, R_NilValue);\n", wname);
+  Printf(f_wrapper, "}\n\n\n");
+
+  Printf(sfile, "# Start of %s\n", vname);
+  Printf(sfile, "`%s` = function(objs%s)\n{\n", vname, 
+	 addCopyParam ? ", .copy = FALSE" : "");
+  Printf(sfile, "  .Call('%s', as.list(objs), %sPACKAGE='%s');\n}\n\n", vwname,
+	 addCopyParam ? "as.logical(.copy), " : "", Rpackage);
+
+  if(outputNamespaceInfo)
+    addNamespaceFunction(vname);
+  addRegistrationRoutine(vwname, addCopyParam ? 2 : 1);
+
+  Delete(vname);
+  Delete(vwname);
+  return SWIG_OK;
+}
+
 /*******************************************************************
  Write the methods for [ or [<- for accessing a member field in an 
  struct or union (or class).
@@ -2106,6 +2137,7 @@ int R::functionWrapper(Node *n) {
 
   Printv(sfun->code, ";", (Len(tm) ? "ans = " : ""), ".Call('", wname, 
 	 "', ", sargs, "PACKAGE='", Rpackage, "');\n", NIL);
+  bool plainResult = Len(tm) == 0 && numOutArgs <= 0 && !isVoidReturnType;
   if(Len(tm))
     {
       Printf(sfun->code, "%s\n\n", tm); 
@@ -2167,6 +2199,20 @@ int R::functionWrapper(Node *n) {
     addAccessor(member_name, sfun, iname);
   }
 
+  /* The getter of a plain data member needs no S-level coercion of its
+     self argument or its result, so the $ method can .Call it directly
+     and a vectorized version can be applied across a list of objects. */
+  if(processing_member_access_function && plainResult && nargs == 1 &&
+     Len(iname) > 4 && !Strcmp(Char(iname) + Len(iname) - 4, "_get")) {
+    if(!directGetters)
+      directGetters = NewHash();
+    String *call = NewStringf("function(x) .Call('%s', x@ref, %sPACKAGE='%s')",
+			      wname, addCopyParam ? "FALSE, " : "", Rpackage);
+    Setattr(directGetters, iname, call);
+    Delete(call);
+    OutputVectorGetter(iname, wname, addCopyParam);
+  }
+
   if (Getattr(n, "sym:overloaded") &&
       !Getattr(n, "sym:nextSibling")) {
     dispatchFunction(n);
@@ -359,6 +359,7 @@ void Swig_overload_check(Node *n);
 String *Swig_overload_dispatch(Node *n, const_String_or_char_ptr fmt, int *);
 String *Swig_overload_dispatch_cast(Node *n, const_String_or_char_ptr fmt, int *);
 String *Swig_overload_dispatch_fast(Node *n, const_String_or_char_ptr fmt, int *);
+String *Swig_overload_dispatch_tree(Node *n, const_String_or_char_ptr fmt, int *);
 List *Swig_overload_rank(Node *n, bool script_lang_wrapping);
 SwigType *cplus_value_type(SwigType *t);
 
@@ -394,6 +395,7 @@ int use_naturalvar_mode(Node *n);
 void Wrapper_virtual_elimination_mode_set(int);
 void Wrapper_fast_dispatch_mode_set(int);
 void Wrapper_cast_dispatch_mode_set(int);
+void Wrapper_tree_dispatch_mode_set(int);
 void Wrapper_naturalvar_mode_set(int);
 
 void clean_overloaded(Node *n);
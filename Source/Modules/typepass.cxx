@@ -37,6 +37,8 @@ class TypePass:private Dispatcher {
   String *nssymname;
   Hash *classhash;
   List *normalize;
+  Node *cleaned_overloads;
+  int cleaned_protected;
 
   TypePass() :
     inclass(0),
@@ -45,7 +47,22 @@ class TypePass:private Dispatcher {
     nsname(0),
     nssymname(0),
     classhash(0),
-    normalize(0) {
+    normalize(0),
+    cleaned_overloads(0),
+    cleaned_protected(0) {
+  }
+
+  /* Clean the overloaded list of n.  Every member of an overloaded set calls
+     this in turn and the list does not change in between, so the walk is only
+     repeated when a different set is reached. */
+  void clean_overloads(Node *n) {
+    Node *over = Getattr(n, "sym:overloaded");
+    int prot = is_non_virtual_protected_access(n);
+    if (over && over == cleaned_overloads && prot == cleaned_protected)
+      return;
+    clean_overloaded(n);
+    cleaned_overloads = Getattr(n, "sym:overloaded");
+    cleaned_protected = prot;
   }
 
   /* Normalize a type. Replaces type with fully qualified version */
@@ -687,7 +704,7 @@ class TypePass:private Dispatcher {
 	Delete(nname);
       }
     }
-    clean_overloaded(n);
+    clean_overloads(n);
     return SWIG_OK;
   }
 
@@ -704,7 +721,7 @@ class TypePass:private Dispatcher {
     normalize_parms(Getattr(n, "parms"));
     normalize_parms(Getattr(n, "throws"));
 
-    clean_overloaded(n);
+    clean_overloads(n);
     return SWIG_OK;
   }
 
@@ -935,6 +952,7 @@ class TypePass:private Dispatcher {
    * ------------------------------------------------------------ */
 
   virtual int usingDeclaration(Node *n) {
+    cleaned_overloads = 0;
     if (Getattr(n, "namespace")) {
       /* using namespace id */
 
@@ -1088,6 +1106,7 @@ class TypePass:private Dispatcher {
 		Node *debugnode = n;
 		show_overloaded(n);
 #endif
+		Swig_symbol_overload_reset(n);
 		if (!firstChild(n)) {
 		  // Remove from overloaded list ('using' node does not actually end up adding in any methods)
 		  Node *ps = Getattr(n, "sym:previousSibling");
@@ -80,6 +80,7 @@ void clean_overloaded(Node *n) {
       /* Remove from overloaded list */
       Node *ps = Getattr(nn, "sym:previousSibling");
       Node *ns = Getattr(nn, "sym:nextSibling");
+      Swig_symbol_overload_reset(nn);
       if (ps) {
 	Setattr(ps, "sym:nextSibling", ns);
       }
@@ -28,6 +28,8 @@ static int import_all = 0;	/* Follow all includes, but as %import statements */
 static int imported_depth = 0;	/* Depth of %imported files */
 static int single_include = 1;	/* Only include each file once */
 static Hash *included_files = 0;
+static Hash *include_guards = 0;	/* Guarded files, by canonical file name */
+static int include_guard_skips = 0;	/* Includes skipped because of a guard */
 static List *dependencies = 0;
 static Scanner *id_scan = 0;
 static int error_as_warning = 0;	/* Understand the cpp #error directive as a special #warning */
@@ -80,35 +82,6 @@ static void copy_location(const DOH *s1, DOH *s2) {
   Setline(s2, Getline((DOH *) s1));
 }
 
-static String *cpp_include(const_String_or_char_ptr fn, int sysfile) {
-  String *s = sysfile ? Swig_include_sys(fn) : Swig_include(fn);
-  if (s && single_include) {
-    String *file = Getfile(s);
-    if (Getattr(included_files, file)) {
-      Delete(s);
-      return 0;
-    }
-    Setattr(included_files, file, file);
-  }
-  if (!s) {
-    if (ignore_missing) {
-      Swig_warning(WARN_PP_MISSING_FILE, Getfile(fn), Getline(fn), "Unable to find '%s'\n", fn);
-    } else {
-      Swig_error(Getfile(fn), Getline(fn), "Unable to find '%s'\n", fn);
-    }
-  } else {
-    String *lf;
-    Seek(s, 0, SEEK_SET);
-    if (!dependencies) {
-      dependencies = NewList();
-    }
-    lf = Copy(Swig_last_file());
-    Append(dependencies, lf);
-    Delete(lf);
-  }
-  return s;
-}
-
 List *Preprocessor_depend(void) {
   return dependencies;
 }
@@ -198,6 +171,7 @@ void Preprocessor_init(void) {
   Delete(s);
   Preprocessor_expr_init();	/* Initialize the expression evaluator */
   included_files = NewHash();
+  include_guards = NewHash();
 
   id_scan = NewScanner();
 
@@ -242,6 +216,7 @@ void Preprocessor_delete(void) {
 
   Delete(cpp);
   Delete(included_files);
+  Delete(include_guards);
   Preprocessor_expr_delete();
   DelScanner(id_scan);
 
@@ -269,6 +244,293 @@ void Preprocessor_error_as_warning(int a) {
   error_as_warning = a;
 }
 
+/* -----------------------------------------------------------------------------
+ * Preprocessor_include_stats()
+ *
+ * Display the files found to have an include guard and the number of includes
+ * skipped because of them.
+ * ----------------------------------------------------------------------------- */
+
+void Preprocessor_include_stats(void) {
+  Iterator ki;
+  Printf(stdout, "Include guards: %d guarded files, %d includes skipped\n", Len(include_guards), include_guard_skips);
+  for (ki = First(include_guards); ki.key; ki = Next(ki)) {
+    Printf(stdout, "  %s: %s\n", ki.key, ki.item);
+  }
+}
+
+/* -----------------------------------------------------------------------------
+ * canonical_file()
+ *
+ * Lexically normalizes a file name by removing empty and "." components and
+ * "dir/.." pairs, so that a file reached through different include paths gets the
+ * same name.  Symbolic links are not resolved.
+ * ----------------------------------------------------------------------------- */
+
+static String *canonical_file(String *file) {
+  char delim = SWIG_FILE_DELIMITER[0];
+  const char *c = Char(file);
+  String *result = NewStringEmpty();
+  List *parts = NewList();
+  int i;
+
+  if (*c == delim)
+    Putc(delim, result);
+  while (*c) {
+    const char *e = strchr(c, delim);
+    int len = e ? (int)(e - c) : (int)strlen(c);
+    if (len == 0 || (len == 1 && c[0] == '.')) {
+      /* Nothing to add */
+    } else if (len == 2 && c[0] == '.' && c[1] == '.' && Len(parts) > 0 && !Equal(Getitem(parts, Len(parts) - 1), "..")) {
+      Delitem(parts, DOH_END);
+    } else {
+      String *part = NewStringWithSize(c, len);
+      Append(parts, part);
+      Delete(part);
+    }
+    c += len;
+    if (*c)
+      c++;
+  }
+  for (i = 0; i < Len(parts); i++) {
+    if (i)
+      Putc(delim, result);
+    Append(result, Getitem(parts, i));
+  }
+  Delete(parts);
+  return result;
+}
+
+/* -----------------------------------------------------------------------------
+ * include_guard()
+ *
+ * Looks for the classic include guard around the whole contents of a file:
+ *
+ *   #ifndef NAME          (or #if !defined(NAME))
+ *   #define NAME
+ *   ...
+ *   #endif
+ *
+ * with nothing but whitespace and comments outside it.  Returns NAME or 0.  While
+ * NAME is defined, including the file again produces nothing, so it need not be
+ * read again.
+ * ----------------------------------------------------------------------------- */
+
+#define GUARD_IS(name, len, s) ((len) == (int)sizeof(s) - 1 && strncmp(name, s, len) == 0)
+
+/* Skip whitespace and comments, stopping at the end of the line unless newlines is set */
+static const char *guard_skip(const char *c, const char *end, int newlines) {
+  while (c < end) {
+    if (*c == '\n' && !newlines) {
+      break;
+    } else if (isspace((unsigned char) *c)) {
+      c++;
+    } else if (*c == '\\' && c + 1 < end && c[1] == '\n') {
+      c += 2;
+    } else if (*c == '/' && c + 1 < end && c[1] == '*') {
+      c += 2;
+      while (c + 1 < end && !(c[0] == '*' && c[1] == '/'))
+	c++;
+      c = (c + 1 < end) ? c + 2 : end;
+    } else if (*c == '/' && c + 1 < end && c[1] == '/') {
+      while (c < end && *c != '\n')
+	c++;
+    } else {
+      break;
+    }
+  }
+  return c;
+}
+
+/* Get the identifier at c, *len is 0 if there is none */
+static const char *guard_id(const char *c, const char *end, const char **id, int *len) {
+  *id = c;
+  if (c < end && isidentifier((unsigned char) *c)) {
+    while (c < end && isidchar((unsigned char) *c))
+      c++;
+  }
+  *len = (int)(c - *id);
+  return c;
+}
+
+static String *include_guard(String *s) {
+  const char *c = Char(s);
+  const char *end = c + Len(s);
+  const char *id;
+  const char *guard = 0;
+  int len, guard_len = 0;
+  int level = 1;
+  int bol = 0;
+
+  /* #ifndef NAME or #if !defined(NAME) or #if !defined NAME */
+  c = guard_skip(c, end, 1);
+  if (c == end || *c != '#')
+    return 0;
+  c = guard_id(guard_skip(c + 1, end, 0), end, &id, &len);
+  if (GUARD_IS(id, len, "ifndef")) {
+    c = guard_id(guard_skip(c, end, 0), end, &guard, &guard_len);
+  } else if (GUARD_IS(id, len, "if")) {
+    c = guard_skip(c, end, 0);
+    if (c < end && *c == '!') {
+      c = guard_id(guard_skip(c + 1, end, 0), end, &id, &len);
+      if (GUARD_IS(id, len, "defined")) {
+	int paren;
+	c = guard_skip(c, end, 0);
+	paren = (c < end && *c == '(');
+	if (paren)
+	  c = guard_skip(c + 1, end, 0);
+	c = guard_id(c, end, &guard, &guard_len);
+	if (paren) {
+	  c = guard_skip(c, end, 0);
+	  if (c < end && *c == ')')
+	    c++;
+	  else
+	    guard_len = 0;
+	}
+      }
+    }
+  }
+  if (!guard_len)
+    return 0;
+  c = guard_skip(c, end, 0);
+  if (c < end && *c != '\n')
+    return 0;
+
+  /* #define NAME */
+  c = guard_skip(c, end, 1);
+  if (c == end || *c != '#')
+    return 0;
+  c = guard_id(guard_skip(c + 1, end, 0), end, &id, &len);
+  if (!GUARD_IS(id, len, "define"))
+    return 0;
+  c = guard_id(guard_skip(c, end, 0), end, &id, &len);
+  if (len != guard_len || strncmp(id, guard, len) != 0)
+    return 0;
+
+  /* Find the matching #endif, skipping comments, literals and %{ %} blocks */
+  while (c < end && level > 0) {
+    if (bol) {
+      bol = 0;
+      c = guard_skip(c, end, 0);
+      if (c < end && *c == '#') {
+	c = guard_id(guard_skip(c + 1, end, 0), end, &id, &len);
+	if (GUARD_IS(id, len, "if") || GUARD_IS(id, len, "ifdef") || GUARD_IS(id, len, "ifndef")) {
+	  level++;
+	} else if (GUARD_IS(id, len, "endif")) {
+	  level--;
+	} else if (level == 1 && (GUARD_IS(id, len, "else") || GUARD_IS(id, len, "elif"))) {
+	  return 0;
+	}
+      }
+      continue;
+    }
+    switch (*c) {
+    case '\n':
+      bol = 1;
+      c++;
+      break;
+    case '\\':
+      c += (c + 1 < end) ? 2 : 1;
+      break;
+    case '\"':
+    case '\'':
+      {
+	char quote = *c++;
+	while (c < end && *c != quote && *c != '\n') {
+	  if (*c == '\\' && c + 1 < end)
+	    c++;
+	  c++;
+	}
+	if (c < end && *c == quote)
+	  c++;
+      }
+      break;
+    case '/':
+      if (c + 1 < end && (c[1] == '*' || c[1] == '/'))
+	c = guard_skip(c, end, 0);
+      else
+	c++;
+      break;
+    case '%':
+      if (c + 1 < end && c[1] == '{') {
+	c += 2;
+	while (c + 1 < end && !(c[0] == '%' && c[1] == '}'))
+	  c++;
+	c = (c + 1 < end) ? c + 2 : end;
+      } else {
+	c++;
+      }
+      break;
+    default:
+      c++;
+      break;
+    }
+  }
+  if (level > 0 || guard_skip(c, end, 1) != end)
+    return 0;
+  return NewStringWithSize(guard, guard_len);
+}
+
+/* -----------------------------------------------------------------------------
+ * cpp_include()
+ *
+ * Reads a file to be included.  Returns 0 if the file is not to be included
+ * again, or could not be found.
+ * ----------------------------------------------------------------------------- */
+
+static String *cpp_include(const_String_or_char_ptr fn, int sysfile) {
+  String *s = 0;
+  String *file = Swig_include_find(fn, sysfile);
+  String *canonical = file ? canonical_file(file) : 0;
+  if (canonical) {
+    String *guard = Getattr(include_guards, canonical);
+    if (guard && Getattr(Getattr(cpp, kpp_symbols), guard)) {
+      include_guard_skips++;
+      Delete(canonical);
+      Delete(file);
+      return 0;
+    }
+    s = Swig_include(file);
+  }
+  if (!s)
+    s = sysfile ? Swig_include_sys(fn) : Swig_include(fn);
+  if (s && single_include) {
+    String *name = Getfile(s);
+    if (Getattr(included_files, name)) {
+      Delete(canonical);
+      Delete(file);
+      Delete(s);
+      return 0;
+    }
+    Setattr(included_files, name, name);
+  }
+  if (s && canonical) {
+    String *guard = include_guard(s);
+    if (guard) {
+      Setattr(include_guards, canonical, guard);
+      Delete(guard);
+    }
+  }
+  Delete(canonical);
+  Delete(file);
+  if (!s) {
+    if (ignore_missing) {
+      Swig_warning(WARN_PP_MISSING_FILE, Getfile(fn), Getline(fn), "Unable to find '%s'\n", fn);
+    } else {
+      Swig_error(Getfile(fn), Getline(fn), "Unable to find '%s'\n", fn);
+    }
+  } else {
+    String *lf;
+    Seek(s, 0, SEEK_SET);
+    if (!dependencies) {
+      dependencies = NewList();
+    }
+    lf = Copy(Swig_last_file());
+    Append(dependencies, lf);
+    Delete(lf);
+  }
+  return s;
+}
 
 /* -----------------------------------------------------------------------------
  * Preprocessor_define()
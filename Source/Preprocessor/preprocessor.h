@@ -31,6 +31,7 @@ extern "C" {
   extern void Preprocessor_ignore_missing(int);
   extern void Preprocessor_error_as_warning(int);
   extern List *Preprocessor_depend(void);
+  extern void Preprocessor_include_stats(void);
   extern void Preprocessor_expr_init(void);
   extern void Preprocessor_expr_delete(void);
 
@@ -14,6 +14,8 @@
  * ----------------------------------------------------------------------------- */
 
 #include "swig.h"
+#include <sys/types.h>
+#include <sys/stat.h>
 
 static List   *directories = 0;	        /* List of include directories */
 static String *lastpath = 0;	        /* Last file that was included */
@@ -266,6 +268,42 @@ String *Swig_include_sys(const_String_or_char_ptr name) {
   return Swig_include_any(name, 1);
 }
 
+/* -----------------------------------------------------------------------------
+ * Swig_include_find()
+ *
+ * Looks for a file in the same places as Swig_include() or Swig_include_sys(),
+ * but without opening it.  Returns the name the file would be included as, that
+ * is, what Swig_last_file() returns after including it, or NULL if not found.
+ * ----------------------------------------------------------------------------- */
+
+String *Swig_include_find(const_String_or_char_ptr name, int sysfile) {
+  struct stat st;
+  String *filename;
+  List *spath;
+  int i, ilen;
+
+  if (!directories)
+    directories = NewList();
+  assert(directories);
+
+  filename = NewString(name);
+  if (stat(Char(filename), &st) == 0)
+    return filename;
+  spath = Swig_search_path_any(sysfile);
+  ilen = Len(spath);
+  for (i = 0; i < ilen; i++) {
+    Clear(filename);
+    Printf(filename, "%s%s", Getitem(spath, i), name);
+    if (stat(Char(filename), &st) == 0) {
+      Delete(spath);
+      return filename;
+    }
+  }
+  Delete(spath);
+  Delete(filename);
+  return 0;
+}
+
 /* -----------------------------------------------------------------------------
  * Swig_insert_file()
  *
@@ -417,6 +417,93 @@ String *Swig_name_disown(const_String_or_char_ptr nspace, const_String_or_char_p
 }
 
 
+/* -----------------------------------------------------------------------------
+ * Lookup caches
+ *
+ * Swig_name_object_get() and Swig_features_get() probe a name hash with many
+ * variations of the name for every declaration.  The result only depends on
+ * the prefix, name and declarator, so it is remembered until the name hash is
+ * next modified.  A cache is kept for each of the few name hashes in use
+ * (rename, namewarn and features).
+ * ----------------------------------------------------------------------------- */
+
+#define MAX_LOOKUP_CACHES 4
+
+typedef struct {
+  Hash *namehash;		/* Name hash the results were looked up in */
+  Hash *results;		/* Cached results keyed by name, then prefix, then decl */
+  int entries;
+  int lookups;
+  int hits;
+  int flushes;
+} LookupCache;
+
+static LookupCache lookup_caches[MAX_LOOKUP_CACHES];
+static int lookup_caches_count = 0;
+static DOH *lookup_none = 0;	/* Cached result meaning 'not found' */
+
+static LookupCache *lookup_cache(Hash *namehash) {
+  int i;
+  for (i = 0; i < lookup_caches_count; i++) {
+    if (lookup_caches[i].namehash == namehash)
+      return &lookup_caches[i];
+  }
+  if (lookup_caches_count == MAX_LOOKUP_CACHES)
+    return 0;
+  lookup_caches[lookup_caches_count].namehash = namehash;
+  lookup_caches[lookup_caches_count].results = NewHash();
+  return &lookup_caches[lookup_caches_count++];
+}
+
+static void lookup_cache_flush(Hash *namehash) {
+  int i;
+  for (i = 0; i < lookup_caches_count; i++) {
+    if ((lookup_caches[i].namehash == namehash) && Len(lookup_caches[i].results)) {
+      Delete(lookup_caches[i].results);
+      lookup_caches[i].results = NewHash();
+      lookup_caches[i].entries = 0;
+      lookup_caches[i].flushes++;
+    }
+  }
+}
+
+/* Separate tables are used for each part of the key, rather than one table with
+   a combined key, as the combined keys only differ in a few characters.  A null
+   prefix, name or decl is distinct from an empty one. */
+static Hash *lookup_table(Hash *h, const DOH *key, int create) {
+  Hash *t = Getattr(h, key ? key : "$none");
+  if (!t && create) {
+    String *k = key ? Copy(key) : NewString("$none");
+    t = NewHash();
+    Setattr(h, k, t);
+    Delete(t);
+    Delete(k);
+  }
+  return t;
+}
+
+static DOH *lookup_cache_get(LookupCache *cache, const String *prefix, const String *name, const SwigType *decl) {
+  Hash *t = lookup_table(cache->results, name, 0);
+  if (t)
+    t = lookup_table(t, prefix, 0);
+  cache->lookups++;
+  return t ? Getattr(t, decl ? decl : "$none") : 0;
+}
+
+static void lookup_cache_set(LookupCache *cache, const String *prefix, const String *name, const SwigType *decl, DOH *result) {
+  Hash *t = lookup_table(lookup_table(cache->results, name, 1), prefix, 1);
+  if (!lookup_none)
+    lookup_none = NewStringEmpty();
+  if (decl) {
+    SwigType *cd = Copy(decl);
+    Setattr(t, cd, result ? result : lookup_none);
+    Delete(cd);
+  } else {
+    Setattr(t, "$none", result ? result : lookup_none);
+  }
+  cache->entries++;
+}
+
 /* -----------------------------------------------------------------------------
  * Swig_name_object_set()
  *
@@ -429,6 +516,7 @@ void Swig_name_object_set(Hash *namehash, String *name, SwigType *decl, DOH *obj
 #ifdef SWIG_DEBUG
   Printf(stdout, "Swig_name_object_set:  '%s', '%s'\n", name, decl);
 #endif
+  lookup_cache_flush(namehash);
   n = Getattr(namehash, name);
   if (!n) {
     n = NewHash();
@@ -480,7 +568,7 @@ DOH *name_object_get(Hash *namehash, String *tname, SwigType *decl, SwigType *nc
   return rn;
 }
 
-DOH *Swig_name_object_get(Hash *namehash, String *prefix, String *name, SwigType *decl) {
+static DOH *object_get(Hash *namehash, String *prefix, String *name, SwigType *decl) {
   String *tname = NewStringEmpty();
   DOH *rn = 0;
   char *ncdecl = 0;
@@ -517,7 +605,7 @@ DOH *Swig_name_object_get(Hash *namehash, String *prefix, String *name, SwigType
       if (!rn) {
 	String *t_name = SwigType_istemplate_templateprefix(name);
 	if (t_name)
-	  rn = Swig_name_object_get(namehash, prefix, t_name, decl);
+	  rn = object_get(namehash, prefix, t_name, decl);
 	Delete(t_name);
       }
     }
@@ -555,6 +643,25 @@ DOH *Swig_name_object_get(Hash *namehash, String *prefix, String *name, SwigType
   return rn;
 }
 
+DOH *Swig_name_object_get(Hash *namehash, String *prefix, String *name, SwigType *decl) {
+  LookupCache *cache;
+  DOH *rn;
+
+  if (!namehash)
+    return 0;
+  cache = lookup_cache(namehash);
+  if (!cache)
+    return object_get(namehash, prefix, name, decl);
+  rn = lookup_cache_get(cache, prefix, name, decl);
+  if (rn) {
+    cache->hits++;
+    return (rn == lookup_none) ? 0 : rn;
+  }
+  rn = object_get(namehash, prefix, name, decl);
+  lookup_cache_set(cache, prefix, name, decl, rn);
+  return rn;
+}
+
 /* -----------------------------------------------------------------------------
  * Swig_name_object_inherit()
  *
@@ -571,6 +678,7 @@ void Swig_name_object_inherit(Hash *namehash, String *base, String *derived) {
 
   if (!namehash)
     return;
+  lookup_cache_flush(namehash);
 
   /* Temporary hash holding all the entries we add while we iterate over
      namehash itself as we can't modify the latter while iterating over it. */
@@ -660,6 +768,56 @@ void features_get(Hash *features, const String *tname, SwigType *decl, SwigType
   }
 }
 
+/* Collects the features matching prefix, name and decl into found, in the order
+   they are to be applied */
+static void features_lookup(Hash *features, String *prefix, String *name, SwigType *decl, SwigType *ncdecl, Hash *found) {
+  /* Global features */
+  features_get(features, "", 0, 0, found);
+  if (name) {
+    String *tname = NewStringEmpty();
+    /* add features for 'root' template */
+    String *dname = SwigType_istemplate_templateprefix(name);
+    if (dname) {
+      features_get(features, dname, decl, ncdecl, found);
+    }
+    /* Catch-all */
+    features_get(features, name, decl, ncdecl, found);
+    /* Perform a class-based lookup (if class prefix supplied) */
+    if (prefix) {
+      /* A class-generic feature */
+      if (Len(prefix)) {
+	Printf(tname, "%s::", prefix);
+	features_get(features, tname, decl, ncdecl, found);
+      }
+      /* A wildcard-based class lookup */
+      Clear(tname);
+      Printf(tname, "*::%s", name);
+      features_get(features, tname, decl, ncdecl, found);
+      /* A specific class lookup */
+      if (Len(prefix)) {
+	/* A template-based class lookup */
+	String *tprefix = SwigType_istemplate_templateprefix(prefix);
+	if (tprefix) {
+	  Clear(tname);
+	  Printf(tname, "%s::%s", tprefix, name);
+	  features_get(features, tname, decl, ncdecl, found);
+	}
+	Clear(tname);
+	Printf(tname, "%s::%s", prefix, name);
+	features_get(features, tname, decl, ncdecl, found);
+	Delete(tprefix);
+      }
+    } else {
+      /* Lookup in the global namespace only */
+      Clear(tname);
+      Printf(tname, "::%s", name);
+      features_get(features, tname, decl, ncdecl, found);
+    }
+    Delete(tname);
+    Delete(dname);
+  }
+}
+
 void Swig_features_get(Hash *features, String *prefix, String *name, SwigType *decl, Node *node) {
   char *ncdecl = 0;
   String *rdecl = 0;
@@ -705,50 +863,20 @@ void Swig_features_get(Hash *features, String *prefix, String *name, SwigType *d
   Printf(stdout, "Swig_features_get: '%s' '%s' '%s'\n", prefix, name, decl);
 #endif
 
-  /* Global features */
-  features_get(features, "", 0, 0, node);
-  if (name) {
-    String *tname = NewStringEmpty();
-    /* add features for 'root' template */
-    String *dname = SwigType_istemplate_templateprefix(name);
-    if (dname) {
-      features_get(features, dname, decl, ncdecl, node);
-    }
-    /* Catch-all */
-    features_get(features, name, decl, ncdecl, node);
-    /* Perform a class-based lookup (if class prefix supplied) */
-    if (prefix) {
-      /* A class-generic feature */
-      if (Len(prefix)) {
-	Printf(tname, "%s::", prefix);
-	features_get(features, tname, decl, ncdecl, node);
-      }
-      /* A wildcard-based class lookup */
-      Clear(tname);
-      Printf(tname, "*::%s", name);
-      features_get(features, tname, decl, ncdecl, node);
-      /* A specific class lookup */
-      if (Len(prefix)) {
-	/* A template-based class lookup */
-	String *tprefix = SwigType_istemplate_templateprefix(prefix);
-	if (tprefix) {
-	  Clear(tname);
-	  Printf(tname, "%s::%s", tprefix, name);
-	  features_get(features, tname, decl, ncdecl, node);
-	}
-	Clear(tname);
-	Printf(tname, "%s::%s", prefix, name);
-	features_get(features, tname, decl, ncdecl, node);
-	Delete(tprefix);
-      }
+  {
+    LookupCache *cache = lookup_cache(features);
+    Hash *found = cache ? lookup_cache_get(cache, prefix, name, decl) : 0;
+    if (found) {
+      cache->hits++;
+      merge_features(found, node);
     } else {
-      /* Lookup in the global namespace only */
-      Clear(tname);
-      Printf(tname, "::%s", name);
-      features_get(features, tname, decl, ncdecl, node);
+      found = NewHash();
+      features_lookup(features, prefix, name, decl, ncdecl, found);
+      if (cache)
+	lookup_cache_set(cache, prefix, name, decl, found);
+      merge_features(found, node);
+      Delete(found);
     }
-    Delete(tname);
-    Delete(dname);
   }
   if (name && SwigType_istemplate(name)) {
     /* add features for complete template type */
@@ -781,6 +909,7 @@ void Swig_feature_set(Hash *features, const_String_or_char_ptr name, SwigType *d
 #ifdef SWIG_DEBUG
   Printf(stdout, "Swig_feature_set: '%s' '%s' '%s' '%s'\n", name, decl, featurename, value);
 #endif
+  lookup_cache_flush(features);
 
   n = Getattr(features, name);
   if (!n) {
@@ -871,6 +1000,23 @@ List *Swig_name_rename_list() {
   return rename_list;
 }
 
+/* -----------------------------------------------------------------------------
+ * Swig_name_lookup_stats()
+ *
+ * Display the usage of the lookup caches, for -debug-lookup.
+ * ----------------------------------------------------------------------------- */
+
+void Swig_name_lookup_stats(void) {
+  int i;
+  Printf(stdout, "Name lookup caches\n");
+  Printf(stdout, "------------\n");
+  for (i = 0; i < lookup_caches_count; i++) {
+    LookupCache *c = &lookup_caches[i];
+    const char *table = (c->namehash == Swig_cparse_features())? "features" : (c->namehash == rename_hash)? "rename" : (c->namehash == namewarn_hash)? "namewarn" : "other";
+    Printf(stdout, "%-10s %d names, %d lookups, %d hits, %d cached, %d flushes\n", table, Len(c->namehash), c->lookups, c->hits, c->entries, c->flushes);
+  }
+}
+
 /* -----------------------------------------------------------------------------
  * int Swig_need_name_warning(Node *n)
  *
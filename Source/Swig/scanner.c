@@ -35,6 +35,9 @@ struct Scanner {
   String *error;                /* Last error message (if any) */
   int     error_line;           /* Error line number */
   int     freeze_line;          /* Suspend line number updates */
+  char   *buf;                  /* Buffer of str when it is a String (else NULL) */
+  char   *cur;                  /* Read position in buf */
+  char   *end;                  /* End of buf */
 };
 
 typedef struct Locator {
@@ -44,6 +47,80 @@ typedef struct Locator {
 } Locator;
 static int follow_locators = 0;
 
+/* -----------------------------------------------------------------------------
+ * load_buffer()
+ * sync_buffer()
+ *
+ * When the object being scanned is a String, characters are read straight out of
+ * its buffer rather than with Getc().  load_buffer() sets up the read position
+ * from the object's current position, sync_buffer() stores it back into the object
+ * before it is set aside.  The object must not be modified while it is scanned.
+ * ----------------------------------------------------------------------------- */
+
+static void load_buffer(Scanner *s) {
+  if (s->str && DohIsString(s->str)) {
+    s->buf = Char(s->str);
+    s->cur = s->buf + Tell(s->str);
+    s->end = s->buf + Len(s->str);
+  } else {
+    s->buf = 0;
+    s->cur = 0;
+    s->end = 0;
+  }
+}
+
+static void sync_buffer(Scanner *s) {
+  if (s->buf)
+    (void)Seek(s->str, (long)(s->cur - s->buf), SEEK_SET);
+}
+
+/* -----------------------------------------------------------------------------
+ * skip_run()
+ *
+ * Fast path for comments, strings, code blocks and skipped code.  Consumes
+ * characters from the buffer up to, but not including, the next character marked
+ * in stop, and appends them to the token text in one go.  The stop tables mark
+ * every character that may change the state of the caller, and NUL.
+ * ----------------------------------------------------------------------------- */
+
+static void skip_run(Scanner * s, const char *stop) {
+  char *start = s->cur;
+  char *p = start;
+  char *end = s->end;
+  int lines = 0;
+
+  while (p < end && !stop[(unsigned char) *p]) {
+    if (*p == '\n')
+      lines++;
+    p++;
+  }
+  if (p != start) {
+    Write(s->text, start, (int)(p - start));
+    s->cur = p;
+    if (!s->freeze_line)
+      s->line += lines;
+  }
+}
+
+static char stop_line[256];		/* Backslash or end of line */
+static char stop_comment[256];		/* Possible end of C comment */
+static char stop_string[256];		/* End of string literal or escape */
+static char stop_char[256];		/* End of character literal or escape */
+static char stop_block[256];		/* Possible end of %{ %} block */
+
+static void init_stop_tables(void) {
+  static int init = 0;
+  if (init)
+    return;
+  stop_line['\\'] = stop_line['\n'] = 1;
+  stop_comment['*'] = 1;
+  stop_string['\"'] = stop_string['\\'] = 1;
+  stop_char['\''] = stop_char['\\'] = 1;
+  stop_block['%'] = 1;
+  stop_line[0] = stop_comment[0] = stop_string[0] = stop_char[0] = stop_block[0] = 1;
+  init = 1;
+}
+
 /* -----------------------------------------------------------------------------
  * NewScanner()
  *
@@ -65,6 +142,10 @@ Scanner *NewScanner(void) {
   s->error = 0;
   s->error_line = 0;
   s->freeze_line = 0;
+  s->buf = 0;
+  s->cur = 0;
+  s->end = 0;
+  init_stop_tables();
   return s;
 }
 
@@ -80,6 +161,7 @@ void DelScanner(Scanner * s) {
   Delete(s->text);
   Delete(s->file);
   Delete(s->error);
+  sync_buffer(s);
   Delete(s->str);
   free(s->idstart);
   free(s);
@@ -93,11 +175,15 @@ void DelScanner(Scanner * s) {
 
 void Scanner_clear(Scanner * s) {
   assert(s);
+  sync_buffer(s);
   Delete(s->str);
   Clear(s->text);
   Clear(s->scanobjs);
   Delete(s->error);
   s->str = 0;
+  s->buf = 0;
+  s->cur = 0;
+  s->end = 0;
   s->error = 0;
   s->line = 1;
   s->nexttoken = -1;
@@ -122,12 +208,14 @@ void Scanner_push(Scanner * s, String *txt) {
   assert(s && txt);
   Push(s->scanobjs, txt);
   if (s->str) {
+    sync_buffer(s);
     Setline(s->str,s->line);
     Delete(s->str);
   }
   s->str = txt;
   DohIncref(s->str);
   s->line = Getline(txt);
+  load_buffer(s);
 }
 
 /* -----------------------------------------------------------------------------
@@ -203,19 +291,28 @@ void Scanner_idstart(Scanner * s, const char *id) {
  * 
  * Returns the next character from the scanner or 0 if end of the string.
  * ----------------------------------------------------------------------------- */
+static int getch(Scanner * s) {
+  if (s->buf)
+    return (s->cur < s->end) ? (int)(unsigned char) *s->cur++ : EOF;
+  return Getc(s->str);
+}
+
 static char nextchar(Scanner * s) {
   int nc;
   if (!s->str)
     return 0;
-  while ((nc = Getc(s->str)) == EOF) {
+  while ((nc = getch(s)) == EOF) {
+    sync_buffer(s);
     Delete(s->str);
     s->str = 0;
+    s->buf = 0;
     Delitem(s->scanobjs, 0);
     if (Len(s->scanobjs) == 0)
       return 0;
     s->str = Getitem(s->scanobjs, 0);
     s->line = Getline(s->str);
     DohIncref(s->str);
+    load_buffer(s);
   }
   if ((nc == '\n') && (!s->freeze_line)) 
     s->line++;
@@ -276,7 +373,12 @@ static void retract(Scanner * s, int n) {
     if (str[l - 1] == '\n') {
       if (!s->freeze_line) s->line--;
     }
-    (void)Seek(s->str, -1, SEEK_CUR);
+    if (s->buf) {
+      if (s->cur > s->buf)
+	s->cur--;
+    } else {
+      (void)Seek(s->str, -1, SEEK_CUR);
+    }
     Delitem(s->text, DOH_END);
   }
 }
@@ -536,13 +638,13 @@ static int look(Scanner * s) {
       if (c == '/') {
 	state = 10;		/* C++ style comment */
 	Clear(s->text);
-	Setline(s->text, Getline(s->str));
+	Setline(s->text, s->line);
 	Setfile(s->text, Getfile(s->str));
 	Append(s->text, "//");
       } else if (c == '*') {
 	state = 11;		/* C style comment */
 	Clear(s->text);
-	Setline(s->text, Getline(s->str));
+	Setline(s->text, s->line);
 	Setfile(s->text, Getfile(s->str));
 	Append(s->text, "/*");
       } else if (c == '=') {
@@ -553,6 +655,8 @@ static int look(Scanner * s) {
       }
       break;
     case 10:			/* C++ style comment */
+      if (s->buf)
+	skip_run(s, stop_line);
       if ((c = nextchar(s)) == 0) {
 	Swig_error(cparse_file, cparse_start_line, "Unterminated comment\n");
 	return SWIG_TOKEN_ERROR;
@@ -565,6 +669,8 @@ static int look(Scanner * s) {
       }
       break;
     case 11:			/* C style comment block */
+      if (s->buf)
+	skip_run(s, stop_comment);
       if ((c = nextchar(s)) == 0) {
 	Swig_error(cparse_file, cparse_start_line, "Unterminated comment\n");
 	return SWIG_TOKEN_ERROR;
@@ -590,6 +696,8 @@ static int look(Scanner * s) {
       break;
 
     case 2:			/* Processing a string */
+      if (s->buf)
+	skip_run(s, stop_string);
       if ((c = nextchar(s)) == 0) {
 	Swig_error(cparse_file, cparse_start_line, "Unterminated string\n");
 	return SWIG_TOKEN_ERROR;
@@ -658,7 +766,7 @@ static int look(Scanner * s) {
       if (c == '{') {
 	state = 40;		/* Include block */
 	Clear(s->text);
-	Setline(s->text, Getline(s->str));
+	Setline(s->text, s->line);
 	Setfile(s->text, Getfile(s->str));
 	s->start_line = s->line;
       } else if (s->idstart && strchr(s->idstart, '%') &&
@@ -673,6 +781,8 @@ static int look(Scanner * s) {
       break;
 
     case 40:			/* Process an include block */
+      if (s->buf)
+	skip_run(s, stop_block);
       if ((c = nextchar(s)) == 0) {
 	Swig_error(cparse_file, cparse_start_line, "Unterminated block\n");
 	return SWIG_TOKEN_ERROR;
@@ -1138,6 +1248,8 @@ void Scanner_skip_line(Scanner * s) {
   Setfile(s->text, Getfile(s->str));
   Setline(s->text, s->line);
   while (!done) {
+    if (s->buf)
+      skip_run(s, stop_line);
     if ((c = nextchar(s)) == 0)
       return;
     if (c == '\\') {
@@ -1161,14 +1273,41 @@ int Scanner_skip_balanced(Scanner * s, int startchar, int endchar) {
   int num_levels = 1;
   int state = 0;
   char temp[2] = { 0, 0 };
+  char stop_code[256];
   String *locator = 0;
   temp[0] = (char) startchar;
   Clear(s->text);
   Setfile(s->text, Getfile(s->str));
   Setline(s->text, s->line);
 
+  memset(stop_code, 0, sizeof(stop_code));
+  stop_code[(unsigned char) startchar] = stop_code[(unsigned char) endchar] = 1;
+  stop_code['/'] = stop_code['\"'] = stop_code['\''] = 1;
+  stop_code[0] = 1;
+
   Append(s->text, temp);
   while (num_levels > 0) {
+    if (s->buf) {
+      switch (state) {
+      case 0:
+	skip_run(s, stop_code);
+	break;
+      case 11:
+	skip_run(s, stop_line);
+	break;
+      case 13:
+	skip_run(s, stop_comment);
+	break;
+      case 20:
+	skip_run(s, stop_string);
+	break;
+      case 30:
+	skip_run(s, stop_char);
+	break;
+      default:
+	break;
+      }
+    }
     if ((c = nextchar(s)) == 0) {
       Delete(locator);
       return -1;
@@ -204,6 +204,7 @@ extern "C" {
   extern void SwigType_remember_mangleddata(String *mangled, const_String_or_char_ptr clientdata);
   extern void (*SwigType_remember_trace(void (*tf) (const SwigType *, String *, String *))) (const SwigType *, String *, String *);
   extern void SwigType_emit_type_table(File *f_headers, File *f_table);
+  extern void SwigType_compact_type_table_mode_set(int flag);
   extern int SwigType_type(const SwigType *t);
 
 /* --- Symbol table module --- */
@@ -234,6 +235,7 @@ extern "C" {
   extern String *Swig_symbol_qualified(Node *node);
   extern Node *Swig_symbol_isoverloaded(Node *node);
   extern void Swig_symbol_remove(Node *node);
+  extern void Swig_symbol_overload_reset(Node *node);
   extern void Swig_symbol_alias(const_String_or_char_ptr aliasname, Symtab *tab);
   extern void Swig_symbol_inherit(Symtab *tab);
   extern SwigType *Swig_symbol_type_qualify(const SwigType *ty, Symtab *tab);
@@ -295,6 +297,7 @@ extern int        ParmList_is_compactdefargs(ParmList *p);
   extern void Swig_name_object_inherit(Hash *namehash, String *base, String *derived);
   extern void Swig_features_get(Hash *features, String *prefix, String *name, SwigType *decl, Node *n);
   extern void Swig_feature_set(Hash *features, const_String_or_char_ptr name, SwigType *decl, const_String_or_char_ptr featurename, String *value, Hash *featureattribs);
+  extern void Swig_name_lookup_stats(void);
 
 /* --- Misc --- */
   extern char *Swig_copy_string(const char *c);
@@ -21,6 +21,7 @@ extern FILE   *Swig_open(const_String_or_char_ptr name);
 extern String *Swig_read_file(FILE *f); 
 extern String *Swig_include(const_String_or_char_ptr name);
 extern String *Swig_include_sys(const_String_or_char_ptr name);
+extern String *Swig_include_find(const_String_or_char_ptr name, int sysfile);
 extern int     Swig_insert_file(const_String_or_char_ptr name, File *outfile);
 extern void    Swig_set_push_dir(int dopush);
 extern int     Swig_get_push_dir(void);
@@ -680,6 +680,62 @@ void Swig_symbol_cadd(const_String_or_char_ptr name, Node *n) {
   }
 }
 
+/* -----------------------------------------------------------------------------
+ * overload_index()
+ *
+ * Returns the index of the overloaded symbols symname in the current scope, c
+ * being the first of them.  The index records the last symbol, the number of
+ * symbols and a list of the symbols for each declarator, so that adding another
+ * overload does not need to walk the whole sym:nextSibling list.  Code that
+ * unlinks symbols from the list must drop the index with
+ * Swig_symbol_overload_reset(), the index is only rebuilt by itself when the
+ * head or the tail of the list has changed.  It is kept in the "$overloads"
+ * attribute of the symbol table, which the node printers leave out.
+ * ----------------------------------------------------------------------------- */
+
+static Hash *overload_index(const_String_or_char_ptr symname, Node *c) {
+  Hash *overloads = Getattr(current_symtab, "$overloads");
+  Hash *index = overloads ? Getattr(overloads, symname) : 0;
+  Hash *decls;
+  Node *cn, *last = 0;
+  int count = 0;
+
+  if (index) {
+    last = Getattr(index, "last");
+    if ((Getattr(index, "head") == c) && !Getattr(last, "sym:nextSibling") && ((last == c) || (Getattr(last, "sym:overloaded") == c)))
+      return index;
+  }
+  if (!overloads) {
+    overloads = NewHash();
+    Setattr(current_symtab, "$overloads", overloads);
+    Delete(overloads);
+  }
+  index = NewHash();
+  decls = NewHash();
+  for (cn = c; cn; cn = Getattr(cn, "sym:nextSibling")) {
+    SwigType *decl = Getattr(cn, "decl");
+    if (decl) {
+      List *l = Getattr(decls, decl);
+      if (!l) {
+	l = NewList();
+	Setattr(decls, decl, l);
+	Delete(l);
+      }
+      Append(l, cn);
+    }
+    last = cn;
+    count++;
+  }
+  Setattr(index, "head", c);
+  Setattr(index, "last", last);
+  SetInt(index, "count", count);
+  Setattr(index, "decls", decls);
+  Setattr(overloads, symname, index);
+  Delete(decls);
+  Delete(index);
+  return index;
+}
+
 /* ----------------------------------------------------------------------------- 
  * Swig_symbol_add()
  *
@@ -853,32 +909,44 @@ Node *Swig_symbol_add(const_String_or_char_ptr symname, Node *n) {
       return c;
     }
 
-    /* Okay. Walk down the list of symbols and see if we get a declarator match */
+    /* Okay. Look up the symbols with the same declarator in the overload index */
     {
       String *nt = Getattr(n, "nodeType");
       int n_template = Equal(nt, "template") && Checkattr(n, "templatetype", "cdecl");
       int n_plain_cdecl = Equal(nt, "cdecl");
-      cn = c;
-      pn = 0;
-      while (cn) {
-	decl = Getattr(cn, "decl");
-	if (!(u1 || u2)) {
-	  if (Cmp(ndecl, decl) == 0) {
-	    /* Declarator conflict */
-	    /* Now check we don't have a non-templated function overloaded by a templated function with same params,
-	     * eg void foo(); template<typename> void foo(); */
-	    String *cnt = Getattr(cn, "nodeType");
-	    int cn_template = Equal(cnt, "template") && Checkattr(cn, "templatetype", "cdecl");
-	    int cn_plain_cdecl = Equal(cnt, "cdecl");
-	    if (!((n_template && cn_plain_cdecl) || (cn_template && n_plain_cdecl))) {
-	      /* found a conflict */
-	      return cn;
-	    }
+      Hash *index = overload_index(symname, c);
+      List *same = ndecl ? Getattr(Getattr(index, "decls"), ndecl) : 0;
+      if (same && !(u1 || u2)) {
+	Iterator si;
+	for (si = First(same); si.item; si = Next(si)) {
+	  /* Declarator conflict */
+	  /* Now check we don't have a non-templated function overloaded by a templated function with same params,
+	   * eg void foo(); template<typename> void foo(); */
+	  String *cnt;
+	  int cn_template, cn_plain_cdecl;
+	  cn = si.item;
+	  cnt = Getattr(cn, "nodeType");
+	  cn_template = Equal(cnt, "template") && Checkattr(cn, "templatetype", "cdecl");
+	  cn_plain_cdecl = Equal(cnt, "cdecl");
+	  if (!((n_template && cn_plain_cdecl) || (cn_template && n_plain_cdecl))) {
+	    /* found a conflict */
+	    return cn;
 	  }
 	}
-	cl = cn;
-	cn = Getattr(cn, "sym:nextSibling");
-	pn++;
+      }
+      cl = Getattr(index, "last");
+      pn = GetInt(index, "count");
+
+      /* The new symbol is added to the end of the list below */
+      Setattr(index, "last", n);
+      SetInt(index, "count", pn + 1);
+      if (ndecl) {
+	if (!same) {
+	  same = NewList();
+	  Setattr(Getattr(index, "decls"), ndecl, same);
+	  Delete(same);
+	}
+	Append(same, n);
       }
     }
     /* Well, we made it this far.  Guess we can drop the symbol in place */
@@ -1355,6 +1423,21 @@ Symtab *Swig_symbol_cscope(const_String_or_char_ptr name, Symtab *symtab) {
   return symbol_lookup_qualified(0, symtab, name, 0, 0);
 }
 
+/* -----------------------------------------------------------------------------
+ * Swig_symbol_overload_reset()
+ *
+ * Drops the overload index of the symbol of n.  Must be called whenever a node
+ * is unlinked from a sym:nextSibling list without Swig_symbol_remove().
+ * ----------------------------------------------------------------------------- */
+
+void Swig_symbol_overload_reset(Node *n) {
+  Symtab *symtab = Getattr(n, "sym:symtab");
+  String *symname = Getattr(n, "sym:name");
+  Hash *overloads = symtab ? Getattr(symtab, "$overloads") : 0;
+  if (symname && overloads)
+    Delattr(overloads, symname);
+}
+
 /* -----------------------------------------------------------------------------
  * Swig_symbol_remove()
  *
@@ -1370,9 +1453,10 @@ void Swig_symbol_remove(Node *n) {
   Node *symprev;
   Node *symnext;
   Node *fixovername = 0;
+  Swig_symbol_overload_reset(n);
   symtab = Getattr(n, "sym:symtab");	/* Get symbol table object */
-  symtab = Getattr(symtab, "symtab");	/* Get actual hash table of symbols */
   symname = Getattr(n, "sym:name");
+  symtab = Getattr(symtab, "symtab");	/* Get actual hash table of symbols */
   symprev = Getattr(n, "sym:previousSibling");
   symnext = Getattr(n, "sym:nextSibling");
 
@@ -1968,6 +1968,267 @@ List *SwigType_get_sorted_mangled_list() {
 }
 
 
+/* -----------------------------------------------------------------------------
+ * SwigType_type_table_str()
+ *
+ * Returns the human readable names of a mangled type, separated by '|'.  These
+ * are the local names of the type and their fully resolved versions.
+ * ----------------------------------------------------------------------------- */
+
+static String *SwigType_type_table_str(String *ms) {
+  Hash *lthash = Getattr(r_ltype, ms);
+  Hash *nthash = NewHash();
+  String *nt = 0;
+  Iterator ltiter;
+
+  for (ltiter = First(lthash); ltiter.key; ltiter = Next(ltiter)) {
+    SwigType *lt = ltiter.key;
+    SwigType *rt = SwigType_typedef_resolve_all(lt);
+    /* we save the original type and the fully resolved version */
+    String *ln = SwigType_lstr(lt, 0);
+    String *rn = SwigType_lstr(rt, 0);
+    if (Equal(ln, rn)) {
+      Setattr(nthash, ln, "1");
+    } else {
+      Setattr(nthash, rn, "1");
+      Setattr(nthash, ln, "1");
+    }
+    if (SwigType_istemplate(rt)) {
+      String *dt = Swig_symbol_template_deftype(rt, 0);
+      String *dn = SwigType_lstr(dt, 0);
+      if (!Equal(dn, rn) && !Equal(dn, ln)) {
+	Setattr(nthash, dn, "1");
+      }
+      Delete(dt);
+      Delete(dn);
+    }
+    Delete(ln);
+    Delete(rn);
+    Delete(rt);
+  }
+
+  /* now build nt */
+  for (ltiter = First(nthash); ltiter.key; ltiter = Next(ltiter)) {
+    if (nt) {
+      Printf(nt, "|%s", ltiter.key);
+    } else {
+      nt = NewString(ltiter.key);
+    }
+  }
+  Delete(nthash);
+  return nt;
+}
+
+/* -----------------------------------------------------------------------------
+ * SwigType_compact_type_table_mode_set()
+ *
+ * Selects the compact form of the type table, see
+ * SwigType_emit_compact_type_table().
+ * ----------------------------------------------------------------------------- */
+
+static int compact_type_table_mode = 0;
+
+void SwigType_compact_type_table_mode_set(int flag) {
+  compact_type_table_mode = flag;
+}
+
+/* Size of the blocks of the compact type name table, a block is only
+   exceeded by a name that does not fit in an empty block */
+#define COMPACT_NAMES_BLOCK 16384
+
+/* Adds a string to the compact name table and returns its reference */
+static int compact_type_name(List *blocks, Hash *refs, String *name) {
+  String *block = Getitem(blocks, Len(blocks) - 1);
+  String *ref = Getattr(refs, name);
+  int r;
+  if (ref)
+    return atoi(Char(ref));
+  if (Len(block) && (Len(block) + Len(name) + 1 > COMPACT_NAMES_BLOCK)) {
+    block = NewStringEmpty();
+    Append(blocks, block);
+    Delete(block);
+  }
+  r = (Len(blocks) - 1) * COMPACT_NAMES_BLOCK + Len(block);
+  Printf(block, "%s", name);
+  Putc(0, block);
+  ref = NewStringf("%d", r);
+  Setattr(refs, name, ref);
+  Delete(ref);
+  return r;
+}
+
+/* -----------------------------------------------------------------------------
+ * SwigType_emit_compact_type_table()
+ *
+ * Compact form of the type table.  Rather than a swig_type_info structure and a
+ * swig_cast_info array for each type, which all point to each other and need a
+ * relocation for each pointer, the table is emitted as read only data:
+ *
+ *    swig_type_names      - Blocks of the type names, separated by '\0'
+ *    swig_type_compact    - For each type, the offsets of its name and human
+ *                           readable name (-1 if none), and the first entry
+ *                           and number of entries of its casts in swig_cast_compact
+ *    swig_cast_compact    - The casts, pairs of the type index and the index of
+ *                           the converter in swig_cast_converters plus one
+ *                           (0 if none).  Identical cast lists are shared.
+ *    swig_clientdata_types, swig_clientdata_compact
+ *                         - The types with clientdata, terminated by -1
+ *
+ * SWIG_InitializeTypeTable() in swiginit.swg fills in swig_type_initial and
+ * swig_cast_initial from these tables before SWIG_InitializeModule() uses them.
+ * ----------------------------------------------------------------------------- */
+
+static void SwigType_emit_compact_type_table(File *f_forward, File *f_table) {
+  Iterator ki;
+  List *mangled_list = SwigType_get_sorted_mangled_list();
+  List *table_list = NewList();
+  Hash *imported_types = NewHash();
+  Hash *type_index = NewHash();
+  List *blocks = NewList();
+  Hash *name_refs = NewHash();
+  Hash *converter_index = NewHash();
+  Hash *cast_lists = NewHash();
+  String *types = NewStringEmpty();
+  String *casts = NewStringEmpty();
+  String *converters = NewStringEmpty();
+  String *clientdata_types = NewStringEmpty();
+  String *clientdata = NewStringEmpty();
+  String *block = NewStringEmpty();
+  int ncasts = 0;
+  int nconverters = 0;
+  int storage = 0;
+  int i = 0;
+
+  Append(blocks, block);
+  Delete(block);
+
+  /* The exported types and the other types that they are equivalent to */
+  for (ki = First(mangled_list); ki.item; ki = Next(ki)) {
+    List *el = SwigType_equivalent_mangle(ki.item, 0, 0);
+    Iterator ei;
+    Append(table_list, ki.item);
+    for (ei = First(el); ei.item; ei = Next(ei)) {
+      if (!Getattr(r_mangled, ei.item) && !Getattr(imported_types, ei.item)) {
+	Append(table_list, ei.item);
+	Setattr(imported_types, ei.item, "1");
+      }
+    }
+    Delete(el);
+  }
+  SortList(table_list, SwigType_compare_mangled);
+  for (ki = First(table_list); ki.item; ki = Next(ki)) {
+    Printf(f_forward, "#define SWIGTYPE%s swig_types[%d]\n", ki.item, i);
+    SetInt(type_index, ki.item, i++);
+  }
+
+  for (ki = First(table_list); ki.item; ki = Next(ki)) {
+    String *cast_list = NewStringEmpty();
+    String *cast_ref;
+    int name = compact_type_name(blocks, name_refs, ki.item);
+    int str = -1;
+    int count = 0;
+
+    if (Getattr(r_mangled, ki.item)) {
+      String *nt = SwigType_type_table_str(ki.item);
+      const String *cd = SwigType_clientdata_collect(ki.item);
+      List *el = SwigType_equivalent_mangle(ki.item, 0, 0);
+      Iterator ei;
+      if (nt)
+	str = compact_type_name(blocks, name_refs, nt);
+      if (cd) {
+	Printf(clientdata_types, "%d, ", GetInt(type_index, ki.item));
+	Printf(clientdata, "  (void*)%s,\n", cd);
+      }
+      for (ei = First(el); ei.item; ei = Next(ei)) {
+	String *ckey = NewStringf("%s+%s", ei.item, ki.item);
+	String *conv = Getattr(conversions, ckey);
+	int c = 0;
+	if (conv) {
+	  c = GetInt(converter_index, conv);
+	  if (!c) {
+	    c = ++nconverters;
+	    SetInt(converter_index, conv, c);
+	    Printf(converters, "  %s,\n", conv);
+	  }
+	}
+	Printf(cast_list, "%s%d, %d,", Len(cast_list) ? " " : "", GetInt(type_index, ei.item), c);
+	count++;
+	Delete(ckey);
+      }
+      Delete(el);
+      Delete(nt);
+    } else {
+      /* Type only known as the equivalent of another type, it can only be cast to itself */
+      Printf(cast_list, "%d, 0,", GetInt(type_index, ki.item));
+      count = 1;
+    }
+
+    cast_ref = Getattr(cast_lists, cast_list);
+    if (!cast_ref) {
+      cast_ref = NewStringf("%d", ncasts);
+      Setattr(cast_lists, cast_list, cast_ref);
+      Delete(cast_ref);
+      Printf(casts, "  %s\n", cast_list);
+      ncasts += count;
+    }
+    Printf(types, "  %d, %d, %s, %d,\n", name, str, cast_ref, count);
+    storage += count + 1;
+    Delete(cast_list);
+  }
+
+  Printf(f_table, "#define SWIG_COMPACT_TYPE_TABLE\n");
+  Printf(f_table, "#define SWIG_TYPE_NAMES_BLOCK %d\n\n", COMPACT_NAMES_BLOCK);
+  for (ki = First(blocks), i = 0; ki.item; ki = Next(ki), i++) {
+    char *c = Char(ki.item);
+    char *end = c + Len(ki.item);
+    Printf(f_table, "static const char swig_type_names_%d[] =\n", i);
+    if (c == end)
+      Printf(f_table, "  \"\"\n");
+    while (c < end) {
+      Printf(f_table, "  \"%s\\0\"\n", c);
+      c += strlen(c) + 1;
+    }
+    Printf(f_table, ";\n");
+  }
+  Printf(f_table, "static const char *const swig_type_names[] = {\n");
+  for (i = 0; i < Len(blocks); i++)
+    Printf(f_table, "  swig_type_names_%d,\n", i);
+  Printf(f_table, "};\n\n");
+
+  /* empty arrays are not allowed by ISO C */
+  Printf(f_table, "static const int swig_type_compact[] = {\n%s%s};\n\n", types, Len(types) ? "" : "  0\n");
+  Printf(f_table, "static const int swig_cast_compact[] = {\n%s%s};\n\n", casts, Len(casts) ? "" : "  0\n");
+  Printf(f_table, "static const swig_converter_func swig_cast_converters[] = {\n%s%s};\n\n", converters, Len(converters) ? "" : "  0\n");
+  Printf(f_table, "static const int swig_clientdata_types[] = {%s-1};\n", clientdata_types);
+  Printf(f_table, "static void *const swig_clientdata_compact[] = {\n%s%s};\n\n", clientdata, Len(clientdata) ? "" : "  0\n");
+
+  Printf(f_table, "static swig_type_info swig_type_storage[%d];\n", Len(table_list) + 1);
+  Printf(f_table, "static swig_cast_info swig_cast_storage[%d];\n", storage + 1);
+  Printf(f_table, "static swig_type_info *swig_type_initial[%d];\n", Len(table_list) + 1);
+  Printf(f_table, "static swig_cast_info *swig_cast_initial[%d];\n", Len(table_list) + 1);
+  Printf(f_table, "\n/* -------- TYPE CONVERSION AND EQUIVALENCE RULES (END) -------- */\n\n");
+
+  Printf(f_forward, "static swig_type_info *swig_types[%d];\n", Len(table_list) + 1);
+  Printf(f_forward, "static swig_module_info swig_module = {swig_types, %d, 0, 0, 0, 0};\n", Len(table_list));
+  Printf(f_forward, "#define SWIG_TypeQuery(name) SWIG_TypeQueryModule(&swig_module, &swig_module, name)\n");
+  Printf(f_forward, "#define SWIG_MangledTypeQuery(name) SWIG_MangledTypeQueryModule(&swig_module, &swig_module, name)\n");
+  Printf(f_forward, "\n/* -------- TYPES TABLE (END) -------- */\n\n");
+
+  Delete(mangled_list);
+  Delete(table_list);
+  Delete(imported_types);
+  Delete(type_index);
+  Delete(blocks);
+  Delete(name_refs);
+  Delete(converter_index);
+  Delete(cast_lists);
+  Delete(types);
+  Delete(casts);
+  Delete(converters);
+  Delete(clientdata_types);
+  Delete(clientdata);
+}
+
 /* -----------------------------------------------------------------------------
  * SwigType_type_table()
  *
@@ -2012,6 +2273,14 @@ void SwigType_emit_type_table(File *f_forward, File *f_table) {
   Printf(stdout, "%s\n", r_clientdata);
 
 #endif
+  Printf(f_forward, "\n/* -------- TYPES TABLE (BEGIN) -------- */\n\n");
+
+  if (compact_type_table_mode) {
+    SwigType_emit_compact_type_table(f_forward, f_table);
+    Delete(table_list);
+    return;
+  }
+
   table = NewStringEmpty();
   types = NewStringEmpty();
   cast = NewStringEmpty();
@@ -2021,21 +2290,12 @@ void SwigType_emit_type_table(File *f_forward, File *f_table) {
   Printf(table, "static swig_type_info *swig_type_initial[] = {\n");
   Printf(cast_init, "static swig_cast_info *swig_cast_initial[] = {\n");
 
-  Printf(f_forward, "\n/* -------- TYPES TABLE (BEGIN) -------- */\n\n");
-
   mangled_list = SwigType_get_sorted_mangled_list();
   for (ki = First(mangled_list); ki.item; ki = Next(ki)) {
     List *el;
     Iterator ei;
-    SwigType *lt;
-    SwigType *rt = 0;
     String *nt;
-    String *ln;
-    String *rn;
     const String *cd;
-    Hash *lthash;
-    Iterator ltiter;
-    Hash *nthash;
 
     cast_temp = NewStringEmpty();
 
@@ -2048,47 +2308,7 @@ void SwigType_emit_type_table(File *f_forward, File *f_table) {
     if (!cd)
       cd = "0";
 
-    lthash = Getattr(r_ltype, ki.item);
-    nt = 0;
-    nthash = NewHash();
-    ltiter = First(lthash);
-    while (ltiter.key) {
-      lt = ltiter.key;
-      rt = SwigType_typedef_resolve_all(lt);
-      /* we save the original type and the fully resolved version */
-      ln = SwigType_lstr(lt, 0);
-      rn = SwigType_lstr(rt, 0);
-      if (Equal(ln, rn)) {
-        Setattr(nthash, ln, "1");
-      } else {
-	Setattr(nthash, rn, "1");
-	Setattr(nthash, ln, "1");
-      }
-      if (SwigType_istemplate(rt)) {
-        String *dt = Swig_symbol_template_deftype(rt, 0);
-        String *dn = SwigType_lstr(dt, 0);
-        if (!Equal(dn, rn) && !Equal(dn, ln)) {
-          Setattr(nthash, dn, "1");
-        }
-        Delete(dt);
-        Delete(dn);
-      }
-
-      ltiter = Next(ltiter);
-    }
-
-    /* now build nt */
-    ltiter = First(nthash);
-    nt = 0;
-    while (ltiter.key) {
-      if (nt) {
-	 Printf(nt, "|%s", ltiter.key);
-      } else {
-	 nt = NewString(ltiter.key);
-      }
-      ltiter = Next(ltiter);
-    }
-    Delete(nthash);
+    nt = SwigType_type_table_str(ki.item);
 
     Printf(types, "\"%s\", \"%s\", 0, 0, (void*)%s, 0};\n", ki.item, nt, cd);
 
@@ -2119,7 +2339,6 @@ void SwigType_emit_type_table(File *f_forward, File *f_table) {
     Printf(cast, "%s{0, 0, 0, 0}};\n", cast_temp);
     Delete(cast_temp);
     Delete(nt);
-    Delete(rt);
   }
   /* print the tables in the proper order */
   SortList(table_list, SwigType_compare_mangled);